@@ -117,17 +117,17 @@ capture_input_hep_receive(G_GNUC_UNUSED gint fd,
 
     // Create a new packet for this data
     Packet *packet = packet_new(input);
-    PacketFrame *frame = g_malloc0(sizeof(PacketFrame));
+    PacketFrame *frame = packet_frame_new();
     frame->len = frame->caplen = received;
     frame->data = g_bytes_new(buffer, received);
+    storage_memory_account(STORAGE_MEMORY_PACKETS, received);
     packet->frames = g_list_append(packet->frames, frame);
 
-    // Pass packet data to the first dissector
+    // Pass packet data to the first dissector (frame keeps data alive while dissecting)
     PacketDissector *dissector = capture_input_initial_dissector(packet->input);
-    GBytes *rest = packet_dissector_dissect(dissector, packet, g_bytes_ref(frame->data));
+    packet_dissector_dissect(dissector, packet, g_bytes_view(frame->data));
 
     // Free packet if not added to storage
-    if (rest != NULL) g_bytes_unref(rest);
     packet_unref(packet);
 
     return TRUE;
@@ -369,6 +369,10 @@ capture_output_hep_write(CaptureOutput *output, Packet *packet)
     PacketSipData *sip = packet_get_protocol_data(packet, PACKET_PROTO_SIP);
     g_return_if_fail(sip != NULL);
 
+    // Packet SIP payload
+    g_autoptr(GBytes) payload = packet_sip_payload(packet);
+    g_return_if_fail(payload != NULL);
+
     // Get HEP output data
     CaptureOutputHep *hep = CAPTURE_OUTPUT_HEP(output);
 
@@ -462,9 +466,9 @@ capture_output_hep_write(CaptureOutput *output, Packet *packet)
     // Payload
     payload_chunk.vendor_id = g_htons(0x0000);
     payload_chunk.type_id = g_htons(0x000f);
-    payload_chunk.length = g_htons(sizeof(payload_chunk) + g_bytes_get_size(sip->payload));
+    payload_chunk.length = g_htons(sizeof(payload_chunk) + g_bytes_get_size(payload));
 
-    total_len = sizeof(CaptureHepGeneric) + g_bytes_get_size(sip->payload) + ip_len + sizeof(CaptureHepChunk);
+    total_len = sizeof(CaptureHepGeneric) + g_bytes_get_size(payload) + ip_len + sizeof(CaptureHepChunk);
 
     // Authorization key
     if (hep->password != NULL) {
@@ -501,7 +505,7 @@ capture_output_hep_write(CaptureOutput *output, Packet *packet)
 
     // SIP Payload
     g_byte_array_append(data, (gpointer) &payload_chunk, sizeof(CaptureHepChunk));
-    g_byte_array_append(data, (gpointer) sip->payload, (guint) g_bytes_get_size(sip->payload));
+    g_byte_array_append(data, g_bytes_get_data(payload, NULL), (guint) g_bytes_get_size(payload));
 
     // Send payload to HEPv3 Server
     if (send(hep->socket, data->data, data->len, 0) == -1) {
@@ -41,6 +41,7 @@
 #include "capture_pcap.h"
 #include "setting.h"
 #include "packet/packet_link.h"
+#include "packet/packet_fastpath.h"
 #include "storage/storage.h"
 
 // CapturePcap class definition
@@ -69,6 +70,7 @@ capture_input_pcap_parse_packet(CaptureInputPcap *pcap, const struct pcap_pkthdr
     frame->caplen = header->caplen;
     frame->len = header->len;
     frame->data = g_bytes_new(content, header->caplen);
+    storage_memory_account(STORAGE_MEMORY_PACKETS, header->caplen);
 
     // Create a new packet
     Packet *packet = packet_new(CAPTURE_INPUT(pcap));
@@ -81,12 +83,11 @@ capture_input_pcap_parse_packet(CaptureInputPcap *pcap, const struct pcap_pkthdr
         capture_input_loaded_size(input) + header->caplen
     );
 
-    // Pass packet data to the first dissector
+    // Pass packet data to the first dissector (frame keeps data alive while dissecting)
     PacketDissector *dissector = capture_input_initial_dissector(packet->input);
-    GBytes *rest = packet_dissector_dissect(dissector, packet, g_bytes_ref(frame->data));
+    packet_dissector_dissect(dissector, packet, g_bytes_view(frame->data));
 
     // Free packet if not added to storage
-    if (rest != NULL) g_bytes_unref(rest);
     packet_unref(packet);
 }
 
@@ -238,7 +239,7 @@ capture_input_pcap_online(const gchar *dev, GError **error)
     CaptureInput *input = CAPTURE_INPUT(pcap);
     capture_input_set_mode(input, CAPTURE_MODE_ONLINE);
     capture_input_set_source_str(input, dev);
-    capture_input_set_initial_dissector(input, packet_dissector_find_by_id(PACKET_PROTO_LINK));
+    capture_input_set_initial_dissector(input, packet_dissector_fastpath_for_link(pcap->link));
 
     // Create GSource for main loop
     capture_input_set_source(
@@ -302,7 +303,7 @@ capture_input_pcap_offline(const gchar *infile, GError **error)
     CaptureInput *input = CAPTURE_INPUT(pcap);
     capture_input_set_mode(input, CAPTURE_MODE_OFFLINE);
     capture_input_set_source_str(input, basename);
-    capture_input_set_initial_dissector(input, packet_dissector_find_by_id(PACKET_PROTO_LINK));
+    capture_input_set_initial_dissector(input, packet_dissector_fastpath_for_link(pcap->link));
 
     // Get File
     if (g_file_test(infile, G_FILE_TEST_IS_REGULAR)) {
@@ -444,11 +445,15 @@ capture_output_pcap_write(CaptureOutput *self, Packet *packet)
         header.len = frame->len - datalink_size;
         header.ts.tv_sec = packet_frame_seconds(frame);
         header.ts.tv_usec = packet_frame_microseconds(frame);
+        // Get frame contents (may be stored on disk)
+        g_autoptr(GBytes) contents = packet_frame_data(frame);
+        if (contents == NULL)
+            continue;
         // Save this packet
         g_autoptr(GBytes) data = g_bytes_new_from_bytes(
-            frame->data,
+            contents,
             datalink_size,
-            g_bytes_get_size(frame->data) - datalink_size
+            g_bytes_get_size(contents) - datalink_size
         );
         pcap_dump((u_char *) pcap->dumper, &header, g_bytes_get_data(data, NULL));
     }
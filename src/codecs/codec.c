@@ -64,11 +64,13 @@ codec_stream_decode(Stream *stream, GByteArray *decoded, GError **error)
     gint ptime = 20;
     for (guint i = 0; i < g_ptr_array_len(stream->packets); i++) {
         Packet *packet = g_ptr_array_index(stream->packets, i);
-        PacketRtpData *rtp = packet_get_protocol_data(packet, PACKET_PROTO_RTP);
+        g_autoptr(GBytes) payload = packet_rtp_payload(packet);
+        if (payload == NULL)
+            continue;
         g_byte_array_append(
             rtp_payload,
-            g_bytes_get_data(rtp->payload, NULL),
-            g_bytes_get_size(rtp->payload)
+            g_bytes_get_data(payload, NULL),
+            g_bytes_get_size(payload)
         );
         if (prev > 0) {
             gint diff = (packet_time(packet) - prev) / G_MSEC_PER_SEC;
@@ -47,25 +47,58 @@ g_byte_array_offset(GByteArray *array, guint offset)
     return array;
 }
 
-GBytes *
-g_bytes_offset(GBytes *bytes, gsize offset)
+GBytesView
+g_bytes_view(GBytes *bytes)
 {
-    g_return_val_if_fail(bytes != NULL, bytes);
-    g_return_val_if_fail(offset <= g_bytes_get_size(bytes), bytes);
+    GBytesView view = G_BYTES_VIEW_NONE;
+    g_return_val_if_fail(bytes != NULL, view);
 
-    gsize len = g_bytes_get_size(bytes);
-    GBytes *ret = g_bytes_new_from_bytes(bytes, offset, len - offset);
-    g_bytes_unref(bytes);
-    return ret;
+    view.bytes = bytes;
+    view.data = g_bytes_get_data(bytes, &view.len);
+    return view;
+}
+
+GBytesView
+g_bytes_view_offset(GBytesView view, gsize offset)
+{
+    if (offset > view.len)
+        offset = view.len;
+
+    view.data += offset;
+    view.len -= offset;
+    return view;
+}
+
+GBytesView
+g_bytes_view_set_size(GBytesView view, gsize count)
+{
+    if (count < view.len)
+        view.len = count;
+    return view;
 }
 
 GBytes *
-g_bytes_set_size(GBytes *bytes, gsize count)
+g_bytes_view_to_bytes(GBytesView view)
 {
-    g_return_val_if_fail(bytes != NULL, bytes);
-    g_return_val_if_fail(count <= g_bytes_get_size(bytes), bytes);
+    g_return_val_if_fail(!g_bytes_view_is_none(view), NULL);
+
+    gsize size = 0;
+    const guint8 *data = g_bytes_get_data(view.bytes, &size);
+
+    // View contains the whole bytes, just share them
+    if (view.data == data && view.len == size)
+        return g_bytes_ref(view.bytes);
 
-    GBytes *ret = g_bytes_new_from_bytes(bytes, 0, count);
-    g_bytes_unref(bytes);
-    return ret;
+    return g_bytes_new_from_bytes(view.bytes, (gsize) (view.data - data), view.len);
+}
+
+guint64
+g_bytes_view_ascii_casehash(GBytesView view)
+{
+    guint64 hash = G_GUINT64_CONSTANT(0xcbf29ce484222325);
+    for (gsize i = 0; i < view.len; i++) {
+        hash ^= (guint8) g_ascii_tolower(view.data[i]);
+        hash *= G_GUINT64_CONSTANT(0x100000001b3);
+    }
+    return hash;
 }
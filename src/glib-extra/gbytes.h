@@ -40,17 +40,86 @@ G_BEGIN_DECLS
 
 #define g_byte_array_len(array) (array->len)
 
+/**
+ * @brief Borrowed view of a GBytes region
+ *
+ * A view does not hold a reference to the viewed GBytes, it is only valid
+ * while its owner keeps the GBytes alive. Views are passed by value, so
+ * moving or resizing them does not allocate memory.
+ *
+ * Use g_bytes_view_to_bytes() to get a GBytes that can be retained.
+ */
+typedef struct
+{
+    //! Viewed bytes container
+    GBytes *bytes;
+    //! First viewed byte
+    const guint8 *data;
+    //! Number of viewed bytes
+    gsize len;
+} GBytesView;
+
+//! Empty view, not pointing to any data
+#define G_BYTES_VIEW_NONE ((GBytesView) { NULL, NULL, 0 })
+
+#define g_bytes_view_is_none(view) ((view).bytes == NULL)
+#define g_bytes_view_get_data(view) ((view).data)
+#define g_bytes_view_get_size(view) ((view).len)
+
 GByteArray *
 g_byte_array_copy(GByteArray *array);
 
 GByteArray *
 g_byte_array_offset(GByteArray *array, guint offset);
 
-GBytes *
-g_bytes_offset(GBytes *bytes, gsize offset);
+/**
+ * @brief Create a view of the whole GBytes contents
+ * @param bytes GBytes to be viewed
+ * @return view of bytes contents
+ */
+GBytesView
+g_bytes_view(GBytes *bytes);
+
+/**
+ * @brief Skip the first bytes of a view
+ * @param view Original view
+ * @param offset Number of bytes to skip (clamped to view size)
+ * @return view of the remaining bytes
+ */
+GBytesView
+g_bytes_view_offset(GBytesView view, gsize offset);
 
+/**
+ * @brief Limit the number of bytes of a view
+ * @param view Original view
+ * @param count Maximum number of bytes of the view
+ * @return view of the first count bytes
+ */
+GBytesView
+g_bytes_view_set_size(GBytesView view, gsize count);
+
+/**
+ * @brief Create a GBytes with the viewed contents
+ *
+ * The returned GBytes shares memory with the viewed bytes and keeps
+ * them alive until it is unreferenced.
+ *
+ * @param view Viewed data
+ * @return a new reference to a GBytes | NULL for empty views
+ */
 GBytes *
-g_bytes_set_size(GBytes *bytes, gsize count);
+g_bytes_view_to_bytes(GBytesView view);
+
+/**
+ * @brief Calculate a case insensitive 64 bits hash of viewed data
+ *
+ * Views with the same contents ignoring ASCII case will have the same hash.
+ *
+ * @param view Viewed data
+ * @return FNV-1a hash of the lowercase viewed data
+ */
+guint64
+g_bytes_view_ascii_casehash(GBytesView view);
 
 G_END_DECLS
 
@@ -77,11 +77,13 @@ print_storage_count(GMainLoop *loop)
 {
     setbuf(stdout, NULL);
 
+    storage_lock();
     g_print(
         "\rProgress: %d%%\tDialog count: %d",
         capture_manager_load_progress(capture_manager_get_instance()),
         storage_calls_count()
     );
+    storage_unlock();
 
     if (capture_is_running() == FALSE &&
         storage_pending_packets() == 0) {
@@ -212,6 +214,14 @@ main(int argc, char *argv[])
         storage_opts.capture.memory_limit = g_format_size_to_bytes(memory_limit);
     }
 
+    // Seconds without activity before moving calls to cold storage
+    storage_opts.capture.cold_age = (guint) setting_get_intvalue(SETTING_STORAGE_COLD_AGE);
+
+    // Payload trigram index for fast payload filtering
+    storage_opts.capture.payload_index = setting_enabled(SETTING_STORAGE_PAYLOAD_INDEX);
+    storage_opts.capture.payload_index_limit =
+        g_format_size_to_bytes(setting_get_value(SETTING_STORAGE_PAYLOAD_INDEX_LIMIT));
+
     // Disable frame storage if no interface is displayed
     if (no_interface) {
         storage_opts.capture.mode = STORAGE_MODE_NONE;
@@ -440,6 +450,9 @@ main(int argc, char *argv[])
     /************************* Application Main Loop  *************************/
     g_main_loop_run(main_loop);
 
+    // Storage stop (before closing capture outputs)
+    storage_stop(storage);
+
     // Capture stop
     capture_manager_stop(capture);
 
@@ -191,13 +191,13 @@ packet_dissector_add_subdissector(PacketDissector *self, PacketProtocolId id)
     }
 }
 
-GBytes *
-packet_dissector_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+GBytesView
+packet_dissector_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
-    g_return_val_if_fail (PACKET_IS_DISSECTOR(self), NULL);
+    g_return_val_if_fail (PACKET_IS_DISSECTOR(self), G_BYTES_VIEW_NONE);
 
     PacketDissectorClass *klass = PACKET_DISSECTOR_GET_CLASS(self);
-    g_return_val_if_fail (klass->dissect != NULL, NULL);
+    g_return_val_if_fail (klass->dissect != NULL, G_BYTES_VIEW_NONE);
 
     return klass->dissect(self, packet, data);
 }
@@ -213,8 +213,8 @@ packet_dissector_free_data(PacketDissector *self, Packet *packet)
     }
 }
 
-GBytes *
-packet_dissector_next_proto(PacketProtocolId id, Packet *packet, GBytes *data)
+GBytesView
+packet_dissector_next_proto(PacketProtocolId id, Packet *packet, GBytesView data)
 {
     PacketDissector *dissector = packet_dissector_find_by_id(id);
     if (dissector != NULL) {
@@ -224,19 +224,19 @@ packet_dissector_next_proto(PacketProtocolId id, Packet *packet, GBytes *data)
     }
 }
 
-GBytes *
-packet_dissector_next(PacketDissector *current, Packet *packet, GBytes *data)
+GBytesView
+packet_dissector_next(PacketDissector *current, Packet *packet, GBytesView data)
 {
     // No more dissection required
-    if (data == NULL)
-        return NULL;
+    if (g_bytes_view_is_none(data))
+        return data;
 
     PacketDissectorPrivate *priv = packet_dissector_get_instance_private(current);
-    // Call each sub-dissectors until data is parsed (and it returns NULL)
+    // Call each sub-dissectors until data is parsed (and it returns an empty view)
     for (GSList *l = priv->subdissectors; l != NULL; l = l->next) {
         data = packet_dissector_dissect(l->data, packet, data);
         // All data dissected, we're done
-        if (data == NULL) {
+        if (g_bytes_view_is_none(data)) {
             break;
         }
     }
@@ -32,6 +32,7 @@
 
 #include "config.h"
 #include <glib.h>
+#include "glib-extra/gbytes.h"
 #include "packet.h"
 
 G_BEGIN_DECLS
@@ -44,13 +45,20 @@ G_DECLARE_DERIVABLE_TYPE(PacketDissector, packet_dissector, PACKET, DISSECTOR, G
  *
  * A packet handler is able to check raw captured data from the wire
  * and convert it into Packets to be stored.
+ *
+ * Dissectors receive a borrowed view of the data: the viewed bytes are
+ * kept alive by the caller only during the dissect call, so dissectors
+ * that need to retain any data must use g_bytes_view_to_bytes().
+ *
+ * Dissect functions return G_BYTES_VIEW_NONE when all data has been
+ * dissected or a view of the pending data otherwise.
  */
 struct _PacketDissectorClass
 {
     //! Parent class
     GObjectClass parent;
     //! Protocol packet dissector function
-    GBytes *(*dissect)(PacketDissector *self, Packet *packet, GBytes *data);
+    GBytesView (*dissect)(PacketDissector *self, Packet *packet, GBytesView data);
     //! Packet data free function
     void (*free_data)(Packet *package);
 };
@@ -67,17 +75,17 @@ packet_dissector_enabled(PacketProtocolId id);
 void
 packet_dissector_add_subdissector(PacketDissector *self, PacketProtocolId id);
 
-GBytes *
-packet_dissector_dissect(PacketDissector *self, Packet *packet, GBytes *data);
+GBytesView
+packet_dissector_dissect(PacketDissector *self, Packet *packet, GBytesView data);
 
 void
 packet_dissector_free_data(PacketDissector *self, Packet *packet);
 
-GBytes *
-packet_dissector_next_proto(PacketProtocolId id, Packet *packet, GBytes *data);
+GBytesView
+packet_dissector_next_proto(PacketProtocolId id, Packet *packet, GBytesView data);
 
-GBytes *
-packet_dissector_next(PacketDissector *current, Packet *packet, GBytes *data);
+GBytesView
+packet_dissector_next(PacketDissector *current, Packet *packet, GBytesView data);
 
 const gchar *
 packet_dissector_get_name(PacketDissector *self);
@@ -34,6 +34,8 @@
 #include "packet_udp.h"
 #include "packet.h"
 #include "storage/storage.h"
+#include "storage/storage_disk.h"
+#include "storage/storage_cold.h"
 
 /**
  * @brief Packet class definition
@@ -169,10 +171,83 @@ packet_frame_microseconds(const PacketFrame *frame)
     return frame->ts - ((frame->ts / G_USEC_PER_SEC) * G_USEC_PER_SEC);
 }
 
+GBytes *
+packet_frame_data(const PacketFrame *frame)
+{
+    g_return_val_if_fail(frame != NULL, NULL);
+
+    if (frame->data != NULL)
+        return g_bytes_ref(frame->data);
+
+    // Frame contents have been compressed in cold storage
+    if (frame->block != NULL)
+        return storage_cold_load_frame(frame);
+
+    // Frame contents have been moved to disk storage
+    return storage_disk_load_frame(frame);
+}
+
+gboolean
+packet_payload_release(const Packet *packet, GBytes **payload, gsize *offset, gsize *len)
+{
+    // Already released
+    if (*payload == NULL)
+        return TRUE;
+
+    gsize payload_len = 0;
+    const guint8 *payload_data = g_bytes_get_data(*payload, &payload_len);
+
+    for (GList *l = packet->frames; l != NULL; l = l->next) {
+        const PacketFrame *frame = l->data;
+        if (frame->data == NULL)
+            continue;
+
+        gsize frame_len = 0;
+        const guint8 *frame_data = g_bytes_get_data(frame->data, &frame_len);
+
+        // Payload is not part of this frame
+        if (payload_data < frame_data || payload_data + payload_len > frame_data + frame_len)
+            continue;
+
+        // Only single frame packets payloads can be loaded back
+        if (l != packet->frames || l->next != NULL)
+            return FALSE;
+
+        *offset = (gsize) (payload_data - frame_data);
+        *len = payload_len;
+        g_bytes_unref(*payload);
+        *payload = NULL;
+        return TRUE;
+    }
+
+    // Payload is not part of any frame (reassembled or decrypted payloads)
+    return TRUE;
+}
+
+GBytes *
+packet_payload_load(const Packet *packet, gsize offset, gsize len)
+{
+    const PacketFrame *frame = packet_first_frame(packet);
+    g_return_val_if_fail(frame != NULL, NULL);
+
+    g_autoptr(GBytes) contents = packet_frame_data(frame);
+    if (contents == NULL || g_bytes_get_size(contents) < offset + len)
+        return NULL;
+
+    return g_bytes_new_from_bytes(contents, offset, len);
+}
+
 void
 packet_frame_free(PacketFrame *frame)
 {
-    g_bytes_unref(frame->data);
+    if (frame->data != NULL) {
+        storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) g_bytes_get_size(frame->data));
+        g_bytes_unref(frame->data);
+    }
+    if (frame->block != NULL) {
+        storage_cold_block_unref(frame->block);
+    }
+    storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) sizeof(PacketFrame));
     g_free(frame);
 }
 
@@ -180,6 +255,7 @@ PacketFrame *
 packet_frame_new()
 {
     PacketFrame *frame = g_malloc0(sizeof(PacketFrame));
+    storage_memory_account(STORAGE_MEMORY_PACKETS, sizeof(PacketFrame));
     return frame;
 }
 
@@ -220,6 +296,7 @@ packet_finalize(GObject *self)
 
     // Free each frame data
     g_list_free_full(packet->frames, (GDestroyNotify) packet_frame_free);
+    storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) sizeof(Packet));
 
     // Chain GObject dispose
     G_OBJECT_CLASS(packet_parent_class)->dispose(self);
@@ -231,6 +308,7 @@ packet_new(CaptureInput *input)
     // Create a new packet
     Packet *packet = g_object_new(CAPTURE_TYPE_PACKET, NULL);
     packet->input = input;
+    storage_memory_account(STORAGE_MEMORY_PACKETS, sizeof(Packet));
     return packet;
 }
 
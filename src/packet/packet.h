@@ -127,8 +127,16 @@ struct _PacketFrame
     guint32 len;
     //! Capture length (from wire)
     guint32 caplen;
-    //! PCAP Frame content
+    //! PCAP Frame content (NULL if moved to disk or cold storage)
     GBytes *data;
+    //! Disk storage segment with frame content
+    guint segment;
+    //! Cold storage compressed block with frame content
+    struct _StorageColdBlock *block;
+    //! Frame content offset in disk storage segment or cold storage block
+    guint64 offset;
+    //! Frame content size in disk storage segment or cold storage block
+    guint32 size;
 };
 
 Packet *
@@ -191,6 +199,46 @@ packet_frame_seconds(const PacketFrame *frame);
 guint64
 packet_frame_microseconds(const PacketFrame *frame);
 
+/**
+ * @brief Return frame captured contents
+ *
+ * If frame contents have been moved to disk or cold storage, they will be
+ * loaded back from there.
+ *
+ * @param frame Packet frame
+ * @return frame contents reference (must be unreferenced) or NULL
+ */
+GBytes *
+packet_frame_data(const PacketFrame *frame);
+
+/**
+ * @brief Release a protocol payload that points into packet frame contents
+ *
+ * If the payload is part of a single frame packet contents, its location
+ * is stored so it can be loaded back with packet_payload_load() and the
+ * payload reference is released. Payloads not pointing into any frame
+ * (reassembled or decrypted) don't reference frame contents.
+ *
+ * @param packet Packet owner of the payload
+ * @param payload Protocol payload reference, set to NULL if released
+ * @param offset Released payload offset in frame contents
+ * @param len Released payload size
+ * @return TRUE if payload no longer references frame contents, FALSE otherwise
+ */
+gboolean
+packet_payload_release(const Packet *packet, GBytes **payload, gsize *offset, gsize *len);
+
+/**
+ * @brief Load a released protocol payload from packet frame contents
+ *
+ * @param packet Packet owner of the payload
+ * @param offset Released payload offset in frame contents
+ * @param len Released payload size
+ * @return payload reference (must be unreferenced) or NULL
+ */
+GBytes *
+packet_payload_load(const Packet *packet, gsize offset, gsize len);
+
 /**
  * @brief Free allocated memory in Packet frame
  * @param frame Frame pointer to be free'd
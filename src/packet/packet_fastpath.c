@@ -0,0 +1,173 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file packet_fastpath.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in packet_fastpath.h
+ *
+ * Single pass parser for Ethernet (802.1Q) / IPv4 / UDP packets
+ */
+
+#include "config.h"
+#include <glib.h>
+#include <netinet/in.h>
+#include <netinet/if_ether.h>
+#include <pcap.h>
+#include "packet_link.h"
+#include "packet_ip.h"
+#include "packet_udp.h"
+#include "packet_fastpath.h"
+#include "storage/intern.h"
+
+G_DEFINE_TYPE(PacketDissectorFastpath, packet_dissector_fastpath, PACKET_TYPE_DISSECTOR)
+
+//! Ethernet header length (without VLAN tags)
+#define FASTPATH_ETHER_LEN      14
+//! 802.1Q VLAN tag length
+#define FASTPATH_VLAN_LEN       4
+//! IPv4 header length (without options)
+#define FASTPATH_IPV4_LEN       20
+//! UDP header length
+#define FASTPATH_UDP_LEN        8
+
+//! Fast path dissector shared by all Ethernet inputs
+static PacketDissector *fastpath = NULL;
+
+static inline guint16
+packet_fastpath_read16(const guint8 *data)
+{
+    return (guint16) ((data[0] << 8) | data[1]);
+}
+
+static GBytesView
+packet_dissector_fastpath_dissect(PacketDissector *self, Packet *packet, GBytesView data)
+{
+    PacketDissectorFastpath *dissector = PACKET_DISSECTOR_FASTPATH(self);
+
+    // IP or UDP dissectors disabled, use generic dissection
+    if (dissector->udp == NULL)
+        return packet_dissector_dissect(dissector->link, packet, data);
+
+    gsize size = g_bytes_view_get_size(data);
+    const guint8 *frame = g_bytes_view_get_data(data);
+
+    // Ethernet header, skip VLAN tag if present
+    guint offset = FASTPATH_ETHER_LEN;
+    if (size < offset + FASTPATH_IPV4_LEN + FASTPATH_UDP_LEN)
+        return packet_dissector_dissect(dissector->link, packet, data);
+
+    guint16 ether_type = packet_fastpath_read16(frame + 12);
+    if (ether_type == ETHERTYPE_8021Q) {
+        ether_type = packet_fastpath_read16(frame + 16);
+        offset += FASTPATH_VLAN_LEN;
+    }
+
+    // Only IPv4 packets are handled here
+    if (ether_type != ETHERTYPE_IP || size < offset + FASTPATH_IPV4_LEN + FASTPATH_UDP_LEN)
+        return packet_dissector_dissect(dissector->link, packet, data);
+
+    // IPv4 header
+    const guint8 *ip4 = frame + offset;
+    guint8 version = ip4[0] >> 4;
+    guint32 hl = (guint32) (ip4[0] & 0x0F) * 4;
+    guint16 ip_len = packet_fastpath_read16(ip4 + 2);
+    guint16 ip_off = packet_fastpath_read16(ip4 + 6);
+    guint8 ip_proto = ip4[9];
+
+    // Fragmented, non-UDP or malformed packets use generic dissection
+    if (version != 4
+        || hl < FASTPATH_IPV4_LEN
+        || (ip_off & (IP_MF | IP_OFFMASK)) != 0
+        || ip_proto != IPPROTO_UDP
+        || ip_len < hl + FASTPATH_UDP_LEN
+        || offset + ip_len > size) {
+        return packet_dissector_dissect(dissector->link, packet, data);
+    }
+
+    // Save IP Addresses into packet
+    gchar srcip[ADDRESSLEN], dstip[ADDRESSLEN];
+    packet_ip_format_ipv4(ip4 + 12, srcip);
+    packet_ip_format_ipv4(ip4 + 16, dstip);
+    PacketIpData *ip_data = packet_ip_data_new();
+    ip_data->version = version;
+    ip_data->protocol = ip_proto;
+    ip_data->srcip = intern_string(srcip);
+    ip_data->dstip = intern_string(dstip);
+    packet_set_protocol_data(packet, PACKET_PROTO_IP, ip_data);
+
+    // Save UDP ports into packet
+    const guint8 *udp = ip4 + hl;
+    PacketUdpData *udp_data = packet_udp_data_new();
+    udp_data->sport = packet_fastpath_read16(udp);
+    udp_data->dport = packet_fastpath_read16(udp + 2);
+    packet_set_protocol_data(packet, PACKET_PROTO_UDP, udp_data);
+
+    // Get UDP payload (trust IP len content field)
+    data = g_bytes_view_offset(data, offset + hl + FASTPATH_UDP_LEN);
+    data = g_bytes_view_set_size(data, ip_len - hl - FASTPATH_UDP_LEN);
+
+    // Call UDP sub-dissectors
+    return packet_dissector_next(dissector->udp, packet, data);
+}
+
+PacketDissector *
+packet_dissector_fastpath_for_link(gint link_type)
+{
+    if (link_type != DLT_EN10MB)
+        return packet_dissector_find_by_id(PACKET_PROTO_LINK);
+
+    if (fastpath == NULL) {
+        fastpath = packet_dissector_fastpath_new();
+    }
+
+    return fastpath;
+}
+
+static void
+packet_dissector_fastpath_class_init(PacketDissectorFastpathClass *klass)
+{
+    PacketDissectorClass *dissector_class = PACKET_DISSECTOR_CLASS(klass);
+    dissector_class->dissect = packet_dissector_fastpath_dissect;
+}
+
+static void
+packet_dissector_fastpath_init(PacketDissectorFastpath *self)
+{
+    self->link = packet_dissector_find_by_id(PACKET_PROTO_LINK);
+
+    // Fast path requires both IP and UDP dissectors
+    if (packet_dissector_enabled(PACKET_PROTO_IP) && packet_dissector_enabled(PACKET_PROTO_UDP)) {
+        self->udp = packet_dissector_find_by_id(PACKET_PROTO_UDP);
+    }
+}
+
+PacketDissector *
+packet_dissector_fastpath_new()
+{
+    return g_object_new(
+        PACKET_DISSECTOR_TYPE_FASTPATH,
+        "id", PACKET_PROTO_LINK,
+        "name", "LINK",
+        NULL
+    );
+}
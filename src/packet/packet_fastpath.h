@@ -0,0 +1,77 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file packet_fastpath.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage Ethernet/IPv4/UDP fast path dissector
+ *
+ * Most captured packets are plain Ethernet frames (optionally VLAN tagged)
+ * containing non fragmented IPv4 UDP datagrams. This dissector parses all
+ * those headers at once and passes the UDP payload directly to the UDP
+ * sub-dissectors. Any other packet is handled by the generic Link dissector.
+ */
+
+#ifndef __SNGREP_PACKET_FASTPATH_H__
+#define __SNGREP_PACKET_FASTPATH_H__
+
+#include <glib.h>
+#include "dissector.h"
+
+G_BEGIN_DECLS
+
+#define PACKET_DISSECTOR_TYPE_FASTPATH packet_dissector_fastpath_get_type()
+G_DECLARE_FINAL_TYPE(PacketDissectorFastpath, packet_dissector_fastpath, PACKET_DISSECTOR, FASTPATH, PacketDissector)
+
+struct _PacketDissectorFastpath
+{
+    //! Parent structure
+    PacketDissector parent;
+    //! Generic Link dissector for not handled packets
+    PacketDissector *link;
+    //! UDP dissector which sub-dissectors will receive the payload
+    PacketDissector *udp;
+};
+
+/**
+ * @brief Return the first dissector for packets of given datalink
+ *
+ * Ethernet captures use the fast path dissector, while the rest of
+ * link types use the generic Link dissector.
+ *
+ * @param link_type Datalink value provided by libpcap
+ * @return a protocols' dissector pointer
+ */
+PacketDissector *
+packet_dissector_fastpath_for_link(gint link_type);
+
+/**
+ * @brief Create an Ethernet/IPv4/UDP fast path dissector
+ *
+ * @return a protocols' dissector pointer
+ */
+PacketDissector *
+packet_dissector_fastpath_new();
+
+G_END_DECLS
+
+#endif  /* __SNGREP_PACKET_FASTPATH_H__ */
@@ -39,6 +39,7 @@
 #include "packet.h"
 #include "setting.h"
 #include "packet_hep.h"
+#include "storage/intern.h"
 
 G_DEFINE_TYPE(PacketDissectorHep, packet_dissector_hep, PACKET_TYPE_DISSECTOR)
 
@@ -51,8 +52,8 @@ G_DEFINE_TYPE(PacketDissectorHep, packet_dissector_hep, PACKET_TYPE_DISSECTOR)
  *
  * @return packet pointer
  */
-static GBytes *
-packet_dissector_hep_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_hep_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     CaptureHepChunkIp4 src_ip4, dst_ip4;
 #ifdef USE_IPV6
@@ -63,14 +64,14 @@ packet_dissector_hep_dissect(PacketDissector *self, Packet *packet, GBytes *data
     gchar srcip[ADDRESSLEN], dstip[ADDRESSLEN];
     guint16 sport = 0, dport = 0;
     g_autofree gchar *password = NULL;
-    GBytes *payload = NULL;
+    GBytesView payload = G_BYTES_VIEW_NONE;
 
-    if (g_bytes_get_size(data) < sizeof(CaptureHepGeneric))
+    if (g_bytes_view_get_size(data) < sizeof(CaptureHepGeneric))
         return data;
 
     // Copy initial bytes to HEP Generic header
     CaptureHepGeneric hg;
-    memcpy(&hg.header, g_bytes_get_data(data, NULL), sizeof(CaptureHepGeneric));
+    memcpy(&hg.header, g_bytes_view_get_data(data), sizeof(CaptureHepGeneric));
 
     // header HEP3 check
     if (memcmp(hg.header.id, "\x48\x45\x50\x33", 4) != 0)
@@ -80,125 +81,119 @@ packet_dissector_hep_dissect(PacketDissector *self, Packet *packet, GBytes *data
     PacketFrame *frame = g_list_nth_data(packet->frames, 0);
 
     // Limit the data to given length
-    data = g_bytes_new_from_bytes(data, 0, g_ntohs(hg.header.length));
+    data = g_bytes_view_set_size(data, g_ntohs(hg.header.length));
 
     // Remove already parsed ctrl header
-    data = g_bytes_offset(data, sizeof(CaptureHepCtrl));
+    data = g_bytes_view_offset(data, sizeof(CaptureHepCtrl));
 
-    while (g_bytes_get_size(data) > 0) {
+    while (g_bytes_view_get_size(data) >= sizeof(CaptureHepChunk)) {
 
-        CaptureHepChunk *chunk = (CaptureHepChunk *) g_bytes_get_data(data, NULL);
+        CaptureHepChunk *chunk = (CaptureHepChunk *) g_bytes_view_get_data(data);
         guint chunk_vendor = g_ntohs(chunk->vendor_id);
         guint chunk_type = g_ntohs(chunk->type_id);
         guint chunk_len = g_ntohs(chunk->length);
 
         /* Bad length, drop packet */
         if (chunk_len == 0) {
-            return NULL;
+            return G_BYTES_VIEW_NONE;
         }
 
         /* Skip not general chunks */
         if (chunk_vendor != 0) {
-            data = g_bytes_offset(data, chunk_len);
+            data = g_bytes_view_offset(data, chunk_len);
             continue;
         }
 
         switch (chunk_type) {
             case CAPTURE_EEP_CHUNK_INVALID:
-                return NULL;
+                return G_BYTES_VIEW_NONE;
             case CAPTURE_EEP_CHUNK_FAMILY:
-                memcpy(&hg.ip_family, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint8));
+                memcpy(&hg.ip_family, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint8));
                 break;
             case CAPTURE_EEP_CHUNK_PROTO:
-                memcpy(&hg.ip_proto, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint8));
+                memcpy(&hg.ip_proto, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint8));
                 break;
             case CAPTURE_EEP_CHUNK_SRC_IP4:
-                memcpy(&src_ip4, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkIp4));
+                memcpy(&src_ip4, g_bytes_view_get_data(data), sizeof(CaptureHepChunkIp4));
                 inet_ntop(AF_INET, &src_ip4.data, srcip, sizeof(srcip));
                 break;
             case CAPTURE_EEP_CHUNK_DST_IP4:
-                memcpy(&dst_ip4, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkIp4));
+                memcpy(&dst_ip4, g_bytes_view_get_data(data), sizeof(CaptureHepChunkIp4));
                 inet_ntop(AF_INET, &dst_ip4.data, dstip, sizeof(srcip));
                 break;
 #ifdef USE_IPV6
             case CAPTURE_EEP_CHUNK_SRC_IP6:
-                memcpy(&src_ip6, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkIp6));
+                memcpy(&src_ip6, g_bytes_view_get_data(data), sizeof(CaptureHepChunkIp6));
                 inet_ntop(AF_INET6, &src_ip6.data, srcip, sizeof(srcip));
                 break;
             case CAPTURE_EEP_CHUNK_DST_IP6:
-                memcpy(&dst_ip6, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkIp6));
+                memcpy(&dst_ip6, g_bytes_view_get_data(data), sizeof(CaptureHepChunkIp6));
                 inet_ntop(AF_INET6, &dst_ip6.data, dstip, sizeof(dstip));
                 break;
 #endif
             case CAPTURE_EEP_CHUNK_SRC_PORT:
-                memcpy(&hg.src_port, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint16));
+                memcpy(&hg.src_port, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint16));
                 sport = g_ntohs(hg.src_port.data);
                 break;
             case CAPTURE_EEP_CHUNK_DST_PORT:
-                memcpy(&hg.dst_port, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint16));
+                memcpy(&hg.dst_port, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint16));
                 dport = g_ntohs(hg.dst_port.data);
                 break;
             case CAPTURE_EEP_CHUNK_TS_SEC:
-                memcpy(&hg.time_sec, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint32));
+                memcpy(&hg.time_sec, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint32));
                 break;
             case CAPTURE_EEP_CHUNK_TS_USEC:
-                memcpy(&hg.time_usec, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint32));
+                memcpy(&hg.time_usec, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint32));
                 break;
             case CAPTURE_EEP_CHUNK_PROTO_TYPE:
-                memcpy(&hg.proto_t, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint8));
+                memcpy(&hg.proto_t, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint8));
                 break;
             case CAPTURE_EEP_CHUNK_CAPT_ID:
-                memcpy(&hg.capt_id, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunkUint32));
+                memcpy(&hg.capt_id, g_bytes_view_get_data(data), sizeof(CaptureHepChunkUint32));
                 break;
             case CAPTURE_EEP_CHUNK_KEEP_TM:
                 break;
             case CAPTURE_EEP_CHUNK_AUTH_KEY:
-                memcpy(&authkey_chunk, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunk));
+                memcpy(&authkey_chunk, g_bytes_view_get_data(data), sizeof(CaptureHepChunk));
                 guint password_len = g_ntohs(authkey_chunk.length) - sizeof(CaptureHepChunk);
-                password = g_strndup(g_bytes_get_data(data, NULL), password_len);
+                password = g_strndup((const gchar *) g_bytes_view_get_data(data), password_len);
                 break;
             case CAPTURE_EEP_CHUNK_PAYLOAD:
-                memcpy(&payload_chunk, g_bytes_get_data(data, NULL), sizeof(CaptureHepChunk));
+                memcpy(&payload_chunk, g_bytes_view_get_data(data), sizeof(CaptureHepChunk));
                 frame->len = frame->caplen = chunk_len - sizeof(CaptureHepChunk);
-                data = g_bytes_offset(data, sizeof(CaptureHepChunk));
-                payload = g_bytes_new(g_bytes_get_data(data, NULL), frame->len);
+                payload = g_bytes_view_offset(data, sizeof(CaptureHepChunk));
+                payload = g_bytes_view_set_size(payload, frame->len);
                 break;
             case CAPTURE_EEP_CHUNK_CORRELATION_ID:
             default:
                 break;
         }
 
-        // Fixup wrong chunk lengths
-        if (chunk_len > g_bytes_get_size(data))
-            chunk_len = g_bytes_get_size(data);
-
-        // Parse next chunk
-        data = g_bytes_offset(data, chunk_len);
+        // Parse next chunk (fixup wrong chunk lengths)
+        data = g_bytes_view_offset(data, chunk_len);
     }
 
     // Validate password
     const gchar *hep_pass = setting_get_value(SETTING_CAPTURE_HEP_LISTEN_PASS);
     if (hep_pass != NULL) {
         // No password in packet
-        if (strlen(password) == 0)
-            return NULL;
+        if (password == NULL || strlen(password) == 0)
+            return G_BYTES_VIEW_NONE;
         // Check password matches configured
         if (strncmp(password, hep_pass, strlen(hep_pass)) != 0)
-            return NULL;
+            return G_BYTES_VIEW_NONE;
     }
 
     // Generate Packet IP data
-    PacketIpData *ip = g_malloc0(sizeof(PacketIpData));
-    ip->proto.id = PACKET_PROTO_IP;
-    ip->srcip = g_strdup(srcip);
-    ip->dstip = g_strdup(dstip);
+    PacketIpData *ip = packet_ip_data_new();
+    ip->srcip = intern_string(srcip);
+    ip->dstip = intern_string(dstip);
     ip->protocol = hg.ip_proto.data;
     ip->version = (hg.ip_family.data == AF_INET) ? 4 : 6;
     packet_set_protocol_data(packet, PACKET_PROTO_IP, ip);
 
     // Generate Packet UDP data
-    PacketUdpData *udp = g_malloc0(sizeof(PacketHepData));
-    udp->proto.id = PACKET_PROTO_UDP;
+    PacketUdpData *udp = packet_udp_data_new();
     udp->sport = sport;
     udp->dport = dport;
     packet_set_protocol_data(packet, PACKET_PROTO_UDP, udp);
@@ -31,10 +31,15 @@
 #include <arpa/inet.h>
 #include "glib-extra/glib.h"
 #include "packet.h"
+#include "packet_pool.h"
 #include "packet_ip.h"
+#include "storage/intern.h"
 
 G_DEFINE_TYPE(PacketDissectorIp, packet_dissector_ip, PACKET_TYPE_DISSECTOR)
 
+//! Recycled IP protocol data structures
+static PacketDataPool ip_data_pool = PACKET_DATA_POOL_INIT(PacketIpData, 4096);
+
 PacketIpData *
 packet_ip_data(const Packet *packet)
 {
@@ -42,6 +47,30 @@ packet_ip_data(const Packet *packet)
     return packet_get_protocol_data(packet, PACKET_PROTO_IP);
 }
 
+PacketIpData *
+packet_ip_data_new()
+{
+    PacketIpData *ip_data = packet_data_pool_alloc(&ip_data_pool);
+    ip_data->proto.id = PACKET_PROTO_IP;
+    return ip_data;
+}
+
+void
+packet_ip_format_ipv4(const guint8 *addr, gchar *dst)
+{
+    for (guint i = 0; i < 4; i++) {
+        guint8 octet = addr[i];
+        if (octet >= 100) {
+            *dst++ = (gchar) ('0' + octet / 100);
+            *dst++ = (gchar) ('0' + (octet / 10) % 10);
+        } else if (octet >= 10) {
+            *dst++ = (gchar) ('0' + octet / 10);
+        }
+        *dst++ = (gchar) ('0' + octet % 10);
+        *dst++ = (i < 3) ? '.' : '\0';
+    }
+}
+
 static gint
 packet_ip_fragment_sort(const PacketIpFragment **a, const PacketIpFragment **b)
 {
@@ -62,16 +91,17 @@ static void
 packet_ip_fragment_free(PacketIpFragment *fragment)
 {
     // Remove no longer required data
-    g_bytes_unref(fragment->data);
+    if (fragment->data != NULL)
+        g_bytes_unref(fragment->data);
     packet_unref(fragment->packet);
     g_free(fragment);
 }
 
 static void
-packet_ip_fragment_set_data(PacketIpFragment *fragment, GBytes *data)
+packet_ip_fragment_set_data(PacketIpFragment *fragment, GBytesView data)
 {
     // Set fragment payload for future reassembly
-    fragment->data = g_bytes_ref(data);
+    fragment->data = g_bytes_view_to_bytes(data);
 }
 
 static PacketIpDatagram *
@@ -149,19 +179,19 @@ packet_dissector_ip_find_datagram(PacketDissectorIp *dissector, PacketIpFragment
     return NULL;
 }
 
-static GBytes *
-packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     // Get IP dissector information
-    g_return_val_if_fail(PACKET_DISSECTOR_IS_IP(self), NULL);
+    g_return_val_if_fail(PACKET_DISSECTOR_IS_IP(self), G_BYTES_VIEW_NONE);
     PacketDissectorIp *dissector = PACKET_DISSECTOR_IP(self);
 
     // Get IP header
-    struct ip *ip4 = (struct ip *) g_bytes_get_data(data, NULL);
+    struct ip *ip4 = (struct ip *) g_bytes_view_get_data(data);
 
 #ifdef USE_IPV6
     // Get IPv6 header
-    struct ip6_hdr *ip6 = (struct ip6_hdr *) g_bytes_get_data(data, NULL);
+    struct ip6_hdr *ip6 = (struct ip6_hdr *) g_bytes_view_get_data(data);
 #endif
 
     // Create an IP fragment for current data
@@ -184,8 +214,8 @@ packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
             fragment->more = (guint16) (fragment->off & IP_MF);
 
             // Get source and destination IP addresses
-            inet_ntop(AF_INET, &ip4->ip_src, fragment->srcip, INET_ADDRSTRLEN);
-            inet_ntop(AF_INET, &ip4->ip_dst, fragment->dstip, INET_ADDRSTRLEN);
+            packet_ip_format_ipv4((const guint8 *) &ip4->ip_src, fragment->srcip);
+            packet_ip_format_ipv4((const guint8 *) &ip4->ip_dst, fragment->dstip);
             break;
 #ifdef USE_IPV6
         case 6:
@@ -216,24 +246,18 @@ packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
     }
 
     // Save IP Addresses into packet
-    PacketIpData *ip_data = g_malloc0(sizeof(PacketIpData));
-    ip_data->proto.id = PACKET_PROTO_IP;
-    ip_data->srcip = g_strdup(fragment->srcip);
-    ip_data->dstip = g_strdup(fragment->dstip);
+    PacketIpData *ip_data = packet_ip_data_new();
+    ip_data->srcip = intern_string(fragment->srcip);
+    ip_data->dstip = intern_string(fragment->dstip);
     ip_data->version = fragment->version;
     ip_data->protocol = fragment->proto;
     packet_set_protocol_data(packet, PACKET_PROTO_IP, ip_data);
 
     // Remove any payload trailer (trust IP len content field)
-    if (fragment->len < g_bytes_get_size(data)) {
-        data = g_bytes_set_size(data, fragment->len);
-    }
+    data = g_bytes_view_set_size(data, fragment->len);
 
     // Get pending payload
-    data = g_bytes_offset(data, fragment->hl);
-
-    // Set fragment data
-    packet_ip_fragment_set_data(fragment, data);
+    data = g_bytes_view_offset(data, fragment->hl);
 
     // If no fragmentation
     if (fragment->frag == 0) {
@@ -243,6 +267,9 @@ packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
         return packet_dissector_next(self, packet, data);
     }
 
+    // Set fragment data
+    packet_ip_fragment_set_data(fragment, data);
+
     // Look for another packet with same id in IP reassembly list
     PacketIpDatagram *datagram = packet_dissector_ip_find_datagram(dissector, fragment);
 
@@ -260,29 +287,34 @@ packet_dissector_ip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
     // where 'No more fragments is enabled' and it's calculated based on the
     // last fragment offset
     if (fragment->more == 0) {
-        datagram->len = fragment->frag_off + g_bytes_get_size(data);
+        datagram->len = fragment->frag_off + g_bytes_view_get_size(data);
     }
 
     // Add this IP content length to the total captured of the packet
-    datagram->seen += g_bytes_get_size(data);
-
-    // If we have the whole packet (captured length is expected length)
-    if (datagram->seen == datagram->len) {
-        // Sort IP fragments
-        g_ptr_array_sort(datagram->fragments, (GCompareFunc) packet_ip_fragment_sort);
-        // Sort and glue all fragments payload
-        data = packet_ip_datagram_payload(datagram);
-        // Sort and take packet frames
-        packet->frames = packet_ip_datagram_take_frames(datagram);
-        // Remove the datagram information
-        dissector->assembly = g_list_remove(dissector->assembly, datagram);
-        packet_ip_datagram_free(datagram);
-        // Call next dissector
-        return packet_dissector_next(self, packet, data);
+    datagram->seen += g_bytes_view_get_size(data);
+
+    // Wait until we have the whole packet (captured length is expected length)
+    if (datagram->seen != datagram->len) {
+        // Packet handled and stored for IP assembly
+        return data;
     }
 
-    // Packet handled and stored for IP assembly
-    return data;
+    // Sort IP fragments
+    g_ptr_array_sort(datagram->fragments, (GCompareFunc) packet_ip_fragment_sort);
+    // Sort and glue all fragments payload
+    g_autoptr(GBytes) payload = packet_ip_datagram_payload(datagram);
+    // Sort and take packet frames
+    packet->frames = packet_ip_datagram_take_frames(datagram);
+    // Remove the datagram information
+    dissector->assembly = g_list_remove(dissector->assembly, datagram);
+    packet_ip_datagram_free(datagram);
+
+    // Dissect the assembled datagram instead of the last fragment payload
+    data = g_bytes_view(payload);
+    packet_dissector_next(self, packet, data);
+
+    // Assembled payload is only valid during this call, don't return any view of it
+    return G_BYTES_VIEW_NONE;
 }
 
 static void
@@ -301,9 +333,9 @@ packet_dissector_ip_free_data(Packet *packet)
 {
     PacketIpData *ip_data = packet_ip_data(packet);
     g_return_if_fail(ip_data != NULL);
-    g_free(ip_data->srcip);
-    g_free(ip_data->dstip);
-    g_free(ip_data);
+    intern_unref(ip_data->srcip);
+    intern_unref(ip_data->dstip);
+    packet_data_pool_release(&ip_data_pool, ip_data);
 }
 
 static void
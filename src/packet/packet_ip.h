@@ -65,10 +65,10 @@ struct _PacketIpData
     guint32 version;
     //! IP Protocol
     guint8 protocol;
-    //! Source Address
-    gchar *srcip;
-    //! Destination Address
-    gchar *dstip;
+    //! Source Address (interned)
+    const gchar *srcip;
+    //! Destination Address (interned)
+    const gchar *dstip;
 };
 
 struct _PacketIpDatagram
@@ -126,6 +126,28 @@ struct _PacketIpFragment
 PacketIpData *
 packet_ip_data(const Packet *packet);
 
+/**
+ * @brief Create a new IP protocol data structure
+ *
+ * Structures are taken from a shared pool and returned to it when
+ * the packet protocol data is freed.
+ *
+ * @return Pointer to a zeroed PacketIpData
+ */
+PacketIpData *
+packet_ip_data_new();
+
+/**
+ * @brief Write IPv4 address in dotted notation
+ *
+ * Faster alternative to inet_ntop for IPv4 addresses
+ *
+ * @param addr IPv4 address in network byte order
+ * @param dst Destination buffer (at least INET_ADDRSTRLEN bytes)
+ */
+void
+packet_ip_format_ipv4(const guint8 *addr, gchar *dst);
+
 /**
  * @brief Create a IP dissector
  *
@@ -41,15 +41,15 @@
 
 G_DEFINE_TYPE(PacketDissectorLink, packet_dissector_link, PACKET_TYPE_DISSECTOR)
 
-static GBytes *
-packet_dissector_link_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_link_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     // Get capture input from this packet
     CaptureInput *input = packet->input;
-    g_return_val_if_fail(input, NULL);
+    g_return_val_if_fail(input, G_BYTES_VIEW_NONE);
 
     // Packet Link packet only works with PCAP input
-    g_return_val_if_fail(capture_input_tech(input) == CAPTURE_TECH_PCAP, NULL);
+    g_return_val_if_fail(capture_input_tech(input) == CAPTURE_TECH_PCAP, G_BYTES_VIEW_NONE);
 
     // Initialize packet private data
     CaptureInputPcap *pcap = CAPTURE_INPUT_PCAP(input);
@@ -59,9 +59,14 @@ packet_dissector_link_dissect(PacketDissector *self, Packet *packet, GBytes *dat
     // Get Layer header size from link type
     guint offset = (guint) link_size;
 
+    // Not enough data
+    if (g_bytes_view_get_size(data) <= offset) {
+        return G_BYTES_VIEW_NONE;
+    }
+
     // For ethernet, skip VLAN header if present
     if (link_type == DLT_EN10MB) {
-        struct ether_header *eth = (struct ether_header *) g_bytes_get_data(data, NULL);
+        struct ether_header *eth = (struct ether_header *) g_bytes_view_get_data(data);
         if (g_ntohs(eth->ether_type) == ETHERTYPE_8021Q) {
             offset += 4;
         }
@@ -69,7 +74,7 @@ packet_dissector_link_dissect(PacketDissector *self, Packet *packet, GBytes *dat
 
 #ifdef DLT_LINUX_SLL
     if (link_type == DLT_LINUX_SLL) {
-        struct sll_header *sll = (struct sll_header *) packet;
+        struct sll_header *sll = (struct sll_header *) g_bytes_view_get_data(data);
         if (g_ntohs(sll->sll_protocol) == ETHERTYPE_8021Q) {
             offset += 4;
         }
@@ -79,30 +84,29 @@ packet_dissector_link_dissect(PacketDissector *self, Packet *packet, GBytes *dat
     // Skip NFLOG header if present
     if (link_type == DLT_NFLOG) {
         // Parse NFLOG TLV headers
-        while (offset + 8 <= g_bytes_get_size(data)) {
-            data = g_bytes_offset(data, offset);
-            LinkNflogHdr *tlv = (LinkNflogHdr *) g_bytes_get_data(data, NULL);
-
-            if (!tlv) break;
+        while (offset + 8 <= g_bytes_view_get_size(data)) {
+            LinkNflogHdr *tlv = (LinkNflogHdr *) (g_bytes_view_get_data(data) + offset);
 
             if (tlv->tlv_type == NFULA_PAYLOAD) {
                 offset += 4;
                 break;
             }
 
-            if (tlv->tlv_length >= 4) {
-                offset += ((tlv->tlv_length + 3) & ~3); /* next TLV aligned to 4B */
-            }
+            // Invalid TLV length
+            if (tlv->tlv_length < 4)
+                break;
+
+            offset += ((tlv->tlv_length + 3) & ~3); /* next TLV aligned to 4B */
         }
     }
 
     // Not enough data
-    if (g_bytes_get_size(data) <= offset) {
-        return NULL;
+    if (g_bytes_view_get_size(data) <= offset) {
+        return G_BYTES_VIEW_NONE;
     }
 
     // Update pending data
-    data = g_bytes_offset(data, offset);
+    data = g_bytes_view_offset(data, offset);
 
     // Call next dissector
     return packet_dissector_next(self, packet, data);
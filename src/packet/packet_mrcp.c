@@ -96,14 +96,38 @@ packet_mrcp_data(const Packet *packet)
 gchar *
 packet_mrcp_payload_str(const Packet *packet)
 {
-    // Get Packet mrcp data
-    PacketMrcpData *mrcp = packet_mrcp_data(packet);
+    // Get Packet mrcp payload
+    g_autoptr(GBytes) payload = packet_mrcp_payload(packet);
+    g_return_val_if_fail(payload != NULL, NULL);
+
     return g_strndup(
-        g_bytes_get_data(mrcp->payload, NULL),
-        g_bytes_get_size(mrcp->payload)
+        g_bytes_get_data(payload, NULL),
+        g_bytes_get_size(payload)
     );
 }
 
+GBytes *
+packet_mrcp_payload(const Packet *packet)
+{
+    PacketMrcpData *mrcp = packet_mrcp_data(packet);
+    g_return_val_if_fail(mrcp != NULL, NULL);
+
+    if (mrcp->payload != NULL)
+        return g_bytes_ref(mrcp->payload);
+
+    // Payload released, get it back from packet frame contents
+    return packet_payload_load(packet, mrcp->payload_offset, mrcp->payload_len);
+}
+
+gboolean
+packet_mrcp_payload_release(Packet *packet)
+{
+    PacketMrcpData *mrcp = packet_mrcp_data(packet);
+    g_return_val_if_fail(mrcp != NULL, FALSE);
+
+    return packet_payload_release(packet, &mrcp->payload, &mrcp->payload_offset, &mrcp->payload_len);
+}
+
 const gchar *
 packet_mrcp_method_str(const Packet *packet)
 {
@@ -129,6 +153,22 @@ packet_mrcp_request_id(const Packet *packet)
     return mrcp->request_id;
 }
 
+guint64
+packet_mrcp_payload_hash(const Packet *packet)
+{
+    PacketMrcpData *mrcp = packet_mrcp_data(packet);
+    g_return_val_if_fail(mrcp != NULL, 0);
+    return mrcp->payload_hash;
+}
+
+gsize
+packet_mrcp_payload_len(const Packet *packet)
+{
+    PacketMrcpData *mrcp = packet_mrcp_data(packet);
+    g_return_val_if_fail(mrcp != NULL, 0);
+    return mrcp->payload_len;
+}
+
 gboolean
 packet_mrcp_is_request(const Packet *packet)
 {
@@ -138,8 +178,8 @@ packet_mrcp_is_request(const Packet *packet)
     return mrcp->type == MRCP_MESSAGE_REQUEST;
 }
 
-static GBytes *
-packet_dissector_mrcp_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_mrcp_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     gchar *method = NULL;
     gchar *request_state = NULL;
@@ -148,13 +188,13 @@ packet_dissector_mrcp_dissect(PacketDissector *self, Packet *packet, GBytes *dat
     enum PacketMrcpMessageTypes type;
 
     // Ignore too small packets
-    if (g_bytes_get_size(data) < MRCP_VERSION_LEN + 1)
+    if (g_bytes_view_get_size(data) < MRCP_VERSION_LEN + 1)
         return data;
 
     // Convert payload to something we can parse with regular expressions
     g_autoptr(GString) payload = g_string_new_len(
-        (const gchar *) g_bytes_get_data(data, NULL),
-        g_bytes_get_size(data)
+        (const gchar *) g_bytes_view_get_data(data),
+        g_bytes_view_get_size(data)
     );
 
     // All MRCP messages start with version string
@@ -212,7 +252,9 @@ packet_dissector_mrcp_dissect(PacketDissector *self, Packet *packet, GBytes *dat
         mrcp_data->method = g_strdup_printf("%d %s", status_code, request_state);
     }
 
-    mrcp_data->payload = g_bytes_ref(data);
+    mrcp_data->payload = g_bytes_view_to_bytes(data);
+    mrcp_data->payload_len = g_bytes_view_get_size(data);
+    mrcp_data->payload_hash = g_bytes_view_ascii_casehash(data);
     mrcp_data->type = type;
     mrcp_data->request_id = request_id;
 
@@ -255,16 +297,12 @@ packet_dissector_mrcp_dissect(PacketDissector *self, Packet *packet, GBytes *dat
     }
 
     // Check we have a whole packet
-    if (mrcp_data->content_len != g_bytes_get_size(data) - mrcp_size) {
+    if (mrcp_data->content_len != g_bytes_view_get_size(data) - mrcp_size) {
         return data;
     }
 
-    // Handle bad terminated SIP messages
-    if (mrcp_size > g_bytes_get_size(data))
-        mrcp_size = g_bytes_get_size(data);
-
-    // Remove SIP headers from data
-    data = g_bytes_offset(data, mrcp_size);
+    // Remove MRCP headers from data (handle bad terminated MRCP messages)
+    data = g_bytes_view_offset(data, mrcp_size);
 
     // Pass data to sub-dissectors
     packet_dissector_next(self, packet, data);
@@ -281,7 +319,8 @@ packet_dissector_mrcp_free(Packet *packet)
     PacketMrcpData *mrcp_data = packet_mrcp_data(packet);
     g_return_if_fail(mrcp_data != NULL);
 
-    g_bytes_unref(mrcp_data->payload);
+    if (mrcp_data->payload != NULL)
+        g_bytes_unref(mrcp_data->payload);
     g_free(mrcp_data->channel);
     g_free(mrcp_data->method);
     g_free(mrcp_data);
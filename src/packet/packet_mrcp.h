@@ -112,8 +112,14 @@ struct _PacketMrcpData
     guint code;
     //! MRCP Message type
     enum PacketMrcpMessageTypes type;
-    //! MRCP Message payload
+    //! MRCP Message payload, NULL if released
     GBytes *payload;
+    //! Released MRCP payload offset in packet first frame
+    gsize payload_offset;
+    //! MRCP payload size
+    gsize payload_len;
+    //! Case insensitive hash of MRCP Message payload
+    guint64 payload_hash;
     //! MRCP Channel Header value
     gchar *channel;
     //! Content-Length header value
@@ -128,6 +134,27 @@ packet_mrcp_method_from_str(const gchar *method);
 gchar *
 packet_mrcp_payload_str(const Packet *packet);
 
+/**
+ * @brief Get MRCP payload of a packet
+ *
+ * If payload memory has been released, it will be loaded back from
+ * the packet frame contents.
+ *
+ * @param packet Packet with MRCP protocol data
+ * @return payload reference (must be unreferenced) or NULL
+ */
+GBytes *
+packet_mrcp_payload(const Packet *packet);
+
+/**
+ * @brief Release MRCP payload memory if it can be loaded from packet frame
+ *
+ * @param packet Packet with MRCP protocol data
+ * @return TRUE if payload no longer references frame contents, FALSE otherwise
+ */
+gboolean
+packet_mrcp_payload_release(Packet *packet);
+
 const gchar *
 packet_mrcp_method_str(const Packet *packet);
 
@@ -137,6 +164,12 @@ packet_mrcp_method(const Packet *packet);
 guint64
 packet_mrcp_request_id(const Packet *packet);
 
+guint64
+packet_mrcp_payload_hash(const Packet *packet);
+
+gsize
+packet_mrcp_payload_len(const Packet *packet);
+
 gboolean
 packet_mrcp_is_request(const Packet *packet);
 
@@ -0,0 +1,74 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file packet_pool.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in packet_pool.h
+ */
+#include "config.h"
+#include <string.h>
+#include <glib.h>
+#include "packet_pool.h"
+
+gpointer
+packet_data_pool_alloc(PacketDataPool *pool)
+{
+    g_return_val_if_fail(pool != NULL, NULL);
+    g_return_val_if_fail(pool->size >= sizeof(gpointer), NULL);
+
+    g_mutex_lock(&pool->lock);
+    gpointer data = pool->head;
+    if (data != NULL) {
+        pool->head = *((gpointer *) data);
+        pool->count--;
+    }
+    g_mutex_unlock(&pool->lock);
+
+    // Pool is empty, request memory to allocator
+    if (data == NULL)
+        return g_malloc0(pool->size);
+
+    memset(data, 0, pool->size);
+    return data;
+}
+
+void
+packet_data_pool_release(PacketDataPool *pool, gpointer data)
+{
+    g_return_if_fail(pool != NULL);
+
+    if (data == NULL)
+        return;
+
+    g_mutex_lock(&pool->lock);
+    if (pool->count < pool->limit) {
+        *((gpointer *) data) = pool->head;
+        pool->head = data;
+        pool->count++;
+        data = NULL;
+    }
+    g_mutex_unlock(&pool->lock);
+
+    // Pool is full, release memory
+    g_free(data);
+}
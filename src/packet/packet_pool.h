@@ -0,0 +1,85 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file packet_pool.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to recycle fixed size protocol data structures
+ *
+ * Every dissected packet allocates (and later frees) the same small protocol
+ * structures. Instead of going to the allocator for each one, released blocks
+ * are kept in a bounded free list and reused for the next packets.
+ *
+ * Pools are shared between capture and storage threads, so they are mutex
+ * protected.
+ */
+
+#ifndef __SNGREP_PACKET_POOL_H__
+#define __SNGREP_PACKET_POOL_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+//! Shorter declaration of packet data pool structure
+typedef struct _PacketDataPool PacketDataPool;
+
+//! Static initializer for data pools of the given type
+#define PACKET_DATA_POOL_INIT(type, max) { .size = sizeof(type), .limit = (max) }
+
+struct _PacketDataPool
+{
+    //! Pool access lock
+    GMutex lock;
+    //! Size of each block
+    gsize size;
+    //! Maximum number of free blocks kept
+    guint limit;
+    //! Current number of free blocks
+    guint count;
+    //! First free block (each free block points to the next one)
+    gpointer head;
+};
+
+/**
+ * @brief Get a zeroed block from the pool
+ * @param pool Pool to request block from
+ * @return pointer to a block of pool size bytes
+ */
+gpointer
+packet_data_pool_alloc(PacketDataPool *pool);
+
+/**
+ * @brief Return a block to the pool
+ *
+ * If the pool already holds its limit of free blocks, the memory
+ * is released instead.
+ *
+ * @param pool Pool where block was requested
+ * @param data Block pointer
+ */
+void
+packet_data_pool_release(PacketDataPool *pool, gpointer data);
+
+G_END_DECLS
+
+#endif /* __SNGREP_PACKET_POOL_H__ */
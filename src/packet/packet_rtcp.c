@@ -55,13 +55,13 @@ G_DEFINE_TYPE(PacketDissectorRtcp, packet_dissector_rtcp, PACKET_TYPE_DISSECTOR)
  * RFC 5764 Section 5.1.2.  Reception (packet demultiplexing)
  */
 static gboolean
-packet_rtcp_valid(GBytes *data)
+packet_rtcp_valid(GBytesView data)
 {
-    g_return_val_if_fail(data != NULL, FALSE);
-    struct rtcp_hdr_generic *hdr = (struct rtcp_hdr_generic *) g_bytes_get_data(data, NULL);
-    guint8 *content = (guint8*) g_bytes_get_data(data, NULL);
+    g_return_val_if_fail(!g_bytes_view_is_none(data), FALSE);
+    struct rtcp_hdr_generic *hdr = (struct rtcp_hdr_generic *) g_bytes_view_get_data(data);
+    const guint8 *content = g_bytes_view_get_data(data);
 
-    if ((g_bytes_get_size(data) >= RTCP_HDR_LENGTH) &&
+    if ((g_bytes_view_get_size(data) >= RTCP_HDR_LENGTH) &&
         (RTP_VERSION(content[0]) == RTP_VERSION_RFC1889) &&
         (content[0] > 127 && content[0] < 192) &&
         (hdr->type >= 192 && hdr->type <= 223)) {
@@ -72,8 +72,8 @@ packet_rtcp_valid(GBytes *data)
     return FALSE;
 }
 
-static GBytes *
-packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytesView data)
 {
     struct rtcp_hdr_generic hdr;
     struct rtcp_hdr_sr hdr_sr;
@@ -91,14 +91,14 @@ packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet,
     rtcp->proto.id = PACKET_PROTO_RTCP;
 
     // Parse all packet payload headers
-    while (g_bytes_get_size(data) > 0) {
+    while (g_bytes_view_get_size(data) > 0) {
 
         // Check we have at least rtcp generic info
-        if (g_bytes_get_size(data) < sizeof(struct rtcp_hdr_generic))
+        if (g_bytes_view_get_size(data) < sizeof(struct rtcp_hdr_generic))
             break;
 
         // Copy into RTCP generic header
-        memcpy(&hdr, g_bytes_get_data(data, NULL), sizeof(hdr));
+        memcpy(&hdr, g_bytes_view_get_data(data), sizeof(hdr));
 
         // Check RTP version
         if (RTP_VERSION(hdr.version) != RTP_VERSION_RFC1889)
@@ -108,14 +108,14 @@ packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet,
         guint hlen = (guint) g_ntohs(hdr.len) * 4 + 4;
 
         // No enough data for this RTCP header
-        if (hlen > g_bytes_get_size(data))
+        if (hlen > g_bytes_view_get_size(data))
             break;
 
         // Check RTCP packet header type
         switch (hdr.type) {
             case RTCP_HDR_SR:
                 // Get Sender Report header
-                memcpy(&hdr_sr, g_bytes_get_data(data, NULL), sizeof(hdr_sr));
+                memcpy(&hdr_sr, g_bytes_view_get_data(data), sizeof(hdr_sr));
                 rtcp->spc = ntohl(hdr_sr.spc);
                 break;
             case RTCP_HDR_RR:
@@ -127,13 +127,13 @@ packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet,
                 break;
             case RTCP_XR:
                 // Get Sender Report Extended header
-                memcpy(&hdr_xr, g_bytes_get_data(data, NULL), sizeof(hdr_xr));
+                memcpy(&hdr_xr, g_bytes_view_get_data(data), sizeof(hdr_xr));
                 gsize bsize = sizeof(hdr_xr);
 
                 // Read all report blocks
                 while (bsize < (guint) ntohs(hdr_xr.len) * 4 + 4) {
                     // Read block header
-                    guint8 *content = (guint8 *) g_bytes_get_data(data, NULL);
+                    const guint8 *content = g_bytes_view_get_data(data);
                     memcpy(&blk_xr, content + bsize, sizeof(blk_xr));
                     // Check block type
                     switch (blk_xr.type) {
@@ -155,12 +155,12 @@ packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet,
             case RTCP_TOKEN:
             default:
                 // Not handled headers. Skip the rest of this packet
-                data = g_bytes_offset(data, g_bytes_get_size(data));
+                data = g_bytes_view_offset(data, g_bytes_view_get_size(data));
                 break;
         }
 
         // Remove this header data
-        data = g_bytes_offset(data, hlen);
+        data = g_bytes_view_offset(data, hlen);
     }
 
     // Set packet RTP informaiton
@@ -169,7 +169,7 @@ packet_dissector_rtcp_parse(G_GNUC_UNUSED PacketDissector *self, Packet *packet,
     // Add data to storage
     storage_add_packet(packet);
 
-    return NULL;
+    return G_BYTES_VIEW_NONE;
 }
 
 static void
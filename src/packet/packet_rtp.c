@@ -91,6 +91,28 @@ packet_rtp_data(const Packet *packet)
     return rtp;
 }
 
+GBytes *
+packet_rtp_payload(const Packet *packet)
+{
+    PacketRtpData *rtp = packet_rtp_data(packet);
+    g_return_val_if_fail(rtp != NULL, NULL);
+
+    if (rtp->payload != NULL)
+        return g_bytes_ref(rtp->payload);
+
+    // Payload released, get it back from packet frame contents
+    return packet_payload_load(packet, rtp->payload_offset, rtp->payload_len);
+}
+
+gboolean
+packet_rtp_payload_release(Packet *packet)
+{
+    PacketRtpData *rtp = packet_rtp_data(packet);
+    g_return_val_if_fail(rtp != NULL, FALSE);
+
+    return packet_payload_release(packet, &rtp->payload, &rtp->payload_offset, &rtp->payload_len);
+}
+
 PacketRtpEncoding *
 packet_rtp_standard_codec(guint8 code)
 {
@@ -103,14 +125,14 @@ packet_rtp_standard_codec(guint8 code)
     return NULL;
 }
 
-static GBytes *
-packet_dissector_rtp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_rtp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytesView data)
 {
     // Not enough data for a RTP packet
-    if (g_bytes_get_size(data) < sizeof(PacketRtpHdr))
+    if (g_bytes_view_get_size(data) < sizeof(PacketRtpHdr))
         return data;
 
-    PacketRtpHdr *hdr = (PacketRtpHdr *) g_bytes_get_data(data, NULL);
+    PacketRtpHdr *hdr = (PacketRtpHdr *) g_bytes_view_get_data(data);
     // Validate RTP version field
     if (hdr->version != RTP_VERSION_RFC1889)
         return data;
@@ -136,10 +158,10 @@ packet_dissector_rtp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet
     rtp->marker = (hdr->marker == 0x1);
 
     // Remove RTP headers from payload
-    data = g_bytes_offset(data, 12);
+    data = g_bytes_view_offset(data, 12);
 
     // Store RTP payload data
-    rtp->payload = data;
+    rtp->payload = g_bytes_view_to_bytes(data);
 
     // Set packet RTP information
     packet_set_protocol_data(packet, PACKET_PROTO_RTP, rtp);
@@ -150,7 +172,7 @@ packet_dissector_rtp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet
     // Add data to storage
     storage_add_packet(packet);
 
-    return NULL;
+    return G_BYTES_VIEW_NONE;
 }
 
 static void
@@ -164,7 +186,8 @@ packet_dissector_rtp_free(Packet *packet)
         g_free(rtp_data->encoding);
     }
 
-    g_bytes_unref(rtp_data->payload);
+    if (rtp_data->payload != NULL)
+        g_bytes_unref(rtp_data->payload);
     g_free(rtp_data);
 }
 
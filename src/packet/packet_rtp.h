@@ -119,8 +119,12 @@ struct _PacketRtpData
     guint32 ssrc;
     //! RTP Marker set
     gboolean marker;
-    //! RTP payload
+    //! RTP payload, NULL if released
     GBytes *payload;
+    //! Released RTP payload offset in packet first frame
+    gsize payload_offset;
+    //! Released RTP payload size
+    gsize payload_len;
 };
 
 struct _PacketRtpEncoding
@@ -137,6 +141,27 @@ packet_rtp_standard_codec(guint8 code);
 PacketRtpData *
 packet_rtp_data(const Packet *packet);
 
+/**
+ * @brief Get RTP payload of a packet
+ *
+ * If payload memory has been released, it will be loaded back from
+ * the packet frame contents.
+ *
+ * @param packet Packet with RTP protocol data
+ * @return payload reference (must be unreferenced) or NULL
+ */
+GBytes *
+packet_rtp_payload(const Packet *packet);
+
+/**
+ * @brief Release RTP payload memory if it can be loaded from packet frame
+ *
+ * @param packet Packet with RTP protocol data
+ * @return TRUE if payload no longer references frame contents, FALSE otherwise
+ */
+gboolean
+packet_rtp_payload_release(Packet *packet);
+
 PacketDissector *
 packet_dissector_rtp_new();
 
@@ -230,17 +230,17 @@ packet_sdp_dissect_attribute(G_GNUC_UNUSED PacketSdpData *sdp, PacketSdpMedia *m
     }
 }
 
-static GBytes *
-packet_dissector_sdp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_sdp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet, GBytesView data)
 {
     PacketSdpMedia *media = NULL;
 
-    if (g_bytes_get_size(data) == 0)
+    if (g_bytes_view_get_size(data) == 0)
         return data;
 
     g_autoptr(GString) payload = g_string_new_len(
-        (const gchar *) g_bytes_get_data(data, NULL),
-        g_bytes_get_size(data)
+        (const gchar *) g_bytes_view_get_data(data),
+        g_bytes_view_get_size(data)
     );
 
 
@@ -268,7 +268,7 @@ packet_dissector_sdp_dissect(G_GNUC_UNUSED PacketDissector *self, Packet *packet
 
     // Set packet SDP data
     packet_set_protocol_data(packet, PACKET_PROTO_SDP, sdp);
-    return NULL;
+    return G_BYTES_VIEW_NONE;
 }
 
 static void
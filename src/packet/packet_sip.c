@@ -30,6 +30,7 @@
 #include "glib-extra/glib.h"
 #include "packet.h"
 #include "packet_sip.h"
+#include "storage/intern.h"
 #include "storage/storage.h"
 
 G_DEFINE_TYPE(PacketDissectorSip, packet_dissector_sip, PACKET_TYPE_DISSECTOR)
@@ -161,14 +162,38 @@ packet_sip_data(const Packet *packet)
 gchar *
 packet_sip_payload_str(const Packet *packet)
 {
-    // Get Packet sip data
-    PacketSipData *sip = packet_sip_data(packet);
+    // Get Packet sip payload
+    g_autoptr(GBytes) payload = packet_sip_payload(packet);
+    g_return_val_if_fail(payload != NULL, NULL);
+
     return g_strndup(
-        g_bytes_get_data(sip->payload, NULL),
-        g_bytes_get_size(sip->payload)
+        g_bytes_get_data(payload, NULL),
+        g_bytes_get_size(payload)
     );
 }
 
+GBytes *
+packet_sip_payload(const Packet *packet)
+{
+    PacketSipData *sip = packet_sip_data(packet);
+    g_return_val_if_fail(sip != NULL, NULL);
+
+    if (sip->payload != NULL)
+        return g_bytes_ref(sip->payload);
+
+    // Payload released, get it back from packet frame contents
+    return packet_payload_load(packet, sip->payload_offset, sip->payload_len);
+}
+
+gboolean
+packet_sip_payload_release(Packet *packet)
+{
+    PacketSipData *sip = packet_sip_data(packet);
+    g_return_val_if_fail(sip != NULL, FALSE);
+
+    return packet_payload_release(packet, &sip->payload, &sip->payload_offset, &sip->payload_len);
+}
+
 const gchar *
 packet_sip_method_str(const Packet *packet)
 {
@@ -200,6 +225,18 @@ packet_sip_cseq(const Packet *packet)
     return packet_sip_data(packet)->cseq;
 }
 
+guint64
+packet_sip_payload_hash(const Packet *packet)
+{
+    return packet_sip_data(packet)->payload_hash;
+}
+
+gsize
+packet_sip_payload_len(const Packet *packet)
+{
+    return packet_sip_data(packet)->payload_len;
+}
+
 gboolean
 packet_sip_initial_transaction(const Packet *packet)
 {
@@ -212,20 +249,84 @@ packet_sip_auth_data(const Packet *packet)
     return packet_sip_data(packet)->auth;
 }
 
-static GBytes *
-packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+const gchar *
+packet_sip_callid(const Packet *packet)
 {
-    gchar *method = NULL;
-    gchar *resp_code = NULL;
+    return packet_sip_data(packet)->callid;
+}
+
+const gchar *
+packet_sip_xcallid(const Packet *packet)
+{
+    return packet_sip_data(packet)->xcallid;
+}
+
+gchar *
+packet_sip_header(const Packet *packet, enum PacketSipHeader header)
+{
+    PacketSipData *sip = packet_sip_data(packet);
+    g_return_val_if_fail(sip != NULL, NULL);
+    g_return_val_if_fail(header < SIP_HEADER_COUNT, NULL);
+
+    // Header not found while dissecting
+    PacketSipHeaderPos *pos = &sip->headers[header];
+    if (pos->offset == 0)
+        return NULL;
+
+    g_autoptr(GBytes) payload = packet_sip_payload(packet);
+    if (payload == NULL || g_bytes_get_size(payload) < pos->offset + pos->len)
+        return NULL;
+
+    return g_strndup(
+        (const gchar *) g_bytes_get_data(payload, NULL) + pos->offset,
+        pos->len
+    );
+}
+
+/**
+ * @brief Store the position of a header value in the SIP payload
+ *
+ * Only first occurrence of each header is indexed.
+ *
+ * @param sip SIP protocol data of the packet
+ * @param header Indexed header
+ * @param line Full header line
+ * @param line_offset Header line offset in the SIP payload
+ */
+static void
+packet_sip_header_index(PacketSipData *sip, enum PacketSipHeader header,
+                        const gchar *line, guint line_offset)
+{
+    if (sip->headers[header].offset != 0)
+        return;
+
+    const gchar *start = strchr(line, ':');
+    if (start == NULL)
+        return;
+
+    // Trim header value
+    const gchar *end = line + strlen(line);
+    for (start++; start < end && g_ascii_isspace(*start); start++);
+    for (; end > start && g_ascii_isspace(*(end - 1)); end--);
+
+    sip->headers[header].offset = line_offset + (guint) (start - line);
+    sip->headers[header].len = (guint) (end - start);
+}
+
+static GBytesView
+packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytesView data)
+{
+    const gchar *method = NULL;
+    const gchar *resp_code = NULL;
 
     // Ignore too small packets
-    if (g_bytes_get_size(data) < SIP_VERSION_LEN + 1)
+    if (g_bytes_view_get_size(data) < SIP_VERSION_LEN + 1)
         return data;
 
     // Convert payload to something we can parse with regular expressions
     g_autoptr(GString) payload = g_string_new_len(
-        (const gchar *) g_bytes_get_data(data, NULL),
-        g_bytes_get_size(data)
+        (const gchar *) g_bytes_view_get_data(data),
+        g_bytes_view_get_size(data)
     );
 
     // Split SIP payload in lines separated by CRLF
@@ -241,13 +342,13 @@ packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data
     }
 
     if (g_strcmp0(first_line_data[0], SIP_VERSION) == 0) {
-        resp_code = g_strdup(first_line_data[1]);
+        resp_code = first_line_data[1];
     }
 
     if (resp_code == NULL) {
         for (guint i = 0; sip_codes[i].id < 100; i++) {
             if (g_strcmp0(first_line_data[0], sip_codes[i].text) == 0) {
-                method = g_strdup(first_line_data[0]);
+                method = first_line_data[0];
                 break;
             }
         }
@@ -263,13 +364,15 @@ packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data
     sip_data->proto.id = PACKET_PROTO_SIP;
     if (method != NULL) {
         sip_data->code.id = packet_sip_method_from_str(method);
-        sip_data->code.text = method;
+        sip_data->code.text = intern_string(method);
     } else {
         sip_data->code.id = packet_sip_method_from_str(resp_code);
-        sip_data->code.text = resp_code;
+        sip_data->code.text = intern_string(resp_code);
     }
 
-    sip_data->payload = g_bytes_ref(data);
+    sip_data->payload = g_bytes_view_to_bytes(data);
+    sip_data->payload_len = g_bytes_view_get_size(data);
+    sip_data->payload_hash = g_bytes_view_ascii_casehash(data);
 
     // Add SIP information to the packet
     packet_set_protocol_data(packet, PACKET_PROTO_SIP, sip_data);
@@ -286,6 +389,7 @@ packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data
         }
 
         // Sip Headers Size
+        guint line_offset = sip_size;
         sip_size += strlen(line) + 2 /* CRLF */;
 
         g_auto(GStrv) hdr_data = g_strsplit(line, ":", 2);
@@ -298,12 +402,20 @@ packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data
 
 
         if (strcasecmp(hdr_name, "Call-ID") == 0 || strcasecmp(hdr_name, "i") == 0) {
-            sip_data->callid = g_strdup(hdr_value);
+            intern_unref(sip_data->callid);
+            sip_data->callid = intern_string(hdr_value);
         } else if (strcasecmp(hdr_name, "X-Call-ID") == 0 || strcasecmp(hdr_name, "X-CID") == 0) {
-            g_free(sip_data->xcallid);      // In case X-Call-Id is multiple times in the payload
-            sip_data->xcallid = g_strdup(hdr_value);
+            intern_unref(sip_data->xcallid);    // In case X-Call-Id is multiple times in the payload
+            sip_data->xcallid = intern_string(hdr_value);
+        } else if (strcasecmp(hdr_name, "From") == 0 || strcasecmp(hdr_name, "f") == 0) {
+            packet_sip_header_index(sip_data, SIP_HEADER_FROM, line, line_offset);
         } else if (strcasecmp(hdr_name, "To") == 0 || strcasecmp(hdr_name, "t") == 0) {
             sip_data->initial = g_strstr_len(hdr_value, strlen(hdr_value), ";tag=") == NULL;
+            packet_sip_header_index(sip_data, SIP_HEADER_TO, line, line_offset);
+        } else if (strcasecmp(hdr_name, "Reason") == 0) {
+            packet_sip_header_index(sip_data, SIP_HEADER_REASON, line, line_offset);
+        } else if (strcasecmp(hdr_name, "Warning") == 0) {
+            packet_sip_header_index(sip_data, SIP_HEADER_WARNING, line, line_offset);
         } else if (strcasecmp(hdr_name, "Content-Length") == 0 || strcasecmp(hdr_name, "l") == 0) {
             sip_data->content_len = g_ascii_strtoull(hdr_value, NULL, 10);
         } else if (strcasecmp(hdr_name, "CSeq") == 0) {
@@ -323,17 +435,18 @@ packet_dissector_sip_dissect(PacketDissector *self, Packet *packet, GBytes *data
 
     // If this comes from a TCP stream, check we have a whole packet
     if (packet_has_protocol(packet, PACKET_PROTO_TCP)) {
-        if (sip_data->content_len != g_bytes_get_size(data) - sip_size) {
+        if (sip_data->content_len != g_bytes_view_get_size(data) - sip_size) {
             return data;
         }
     }
 
-    // Handle bad terminated SIP messages
-    if (sip_size > g_bytes_get_size(data))
-        sip_size = g_bytes_get_size(data);
+    // Remove SIP headers from data (handle bad terminated SIP messages)
+    data = g_bytes_view_offset(data, sip_size);
 
-    // Remove SIP headers from data
-    data = g_bytes_offset(data, sip_size);
+    // Check this dialog can be stored before any further dissection
+    if (!storage_check_sip_admission(packet)) {
+        return data;
+    }
 
     // Pass data to sub-dissectors
     packet_dissector_next(self, packet, data);
@@ -350,11 +463,12 @@ packet_dissector_sip_free(Packet *packet)
     PacketSipData *sip_data = packet_sip_data(packet);
     g_return_if_fail(sip_data != NULL);
 
-    g_bytes_unref(sip_data->payload);
-    g_free(sip_data->callid);
-    g_free(sip_data->xcallid);
+    if (sip_data->payload != NULL)
+        g_bytes_unref(sip_data->payload);
+    intern_unref(sip_data->callid);
+    intern_unref(sip_data->xcallid);
     g_free(sip_data->auth);
-    g_free(sip_data->code.text);
+    intern_unref(sip_data->code.text);
     g_free(sip_data);
 }
 
@@ -44,6 +44,7 @@ G_DECLARE_FINAL_TYPE(PacketDissectorSip, packet_dissector_sip, PACKET_DISSECTOR,
 
 typedef struct _PacketSipData PacketSipData;
 typedef struct _PacketSipCode PacketSipCode;
+typedef struct _PacketSipHeaderPos PacketSipHeaderPos;
 
 struct _PacketDissectorSip
 {
@@ -70,35 +71,64 @@ enum SipMethods
     SIP_METHOD_BYE,
 };
 
+//! SIP Headers indexed while dissecting
+enum PacketSipHeader
+{
+    SIP_HEADER_FROM = 0,
+    SIP_HEADER_TO,
+    SIP_HEADER_REASON,
+    SIP_HEADER_WARNING,
+    SIP_HEADER_COUNT
+};
+
+/**
+ * @brief Location of a header value in the SIP payload
+ */
+struct _PacketSipHeaderPos
+{
+    //! Header value offset in payload (0 if header is not present)
+    guint offset;
+    //! Header value length
+    guint len;
+};
+
 /**
  * @brief Different Request/Response codes in SIP Protocol
  */
 struct _PacketSipCode
 {
     guint id;
-    gchar *text;
+    const gchar *text;
 };
 
 struct _PacketSipData
 {
     //! Protocol information
     PacketProtocol proto;
-    //! Request Method or Response code data
+    //! Request Method or Response code data (interned text)
     PacketSipCode code;
     //! Is this an initial request? (no to-tag)
     gboolean initial;
-    //! SIP payload (Headers + Body)
+    //! SIP payload (Headers + Body), NULL if released
     GBytes *payload;
+    //! Released SIP payload offset in packet first frame
+    gsize payload_offset;
+    //! SIP payload size
+    gsize payload_len;
+    //! Case insensitive hash of SIP payload
+    guint64 payload_hash;
     //! Content-Length header value
     guint64 content_len;
-    //! SIP Call-Id Header value
-    gchar *callid;
-    //! SIP X-Call-Id Header value
-    gchar *xcallid;
+    //! SIP Call-Id Header value (interned)
+    const gchar *callid;
+    //! SIP X-Call-Id Header value (interned)
+    const gchar *xcallid;
     //! Message Cseq
     guint64 cseq;
     //! SIP Authentication Header value
     gchar *auth;
+    //! First occurrence of indexed headers in payload
+    PacketSipHeaderPos headers[SIP_HEADER_COUNT];
 };
 
 guint
@@ -110,6 +140,30 @@ sip_method_str(guint method);
 gchar *
 packet_sip_payload_str(const Packet *packet);
 
+/**
+ * @brief Get SIP payload (Headers + Body) of a packet
+ *
+ * If payload memory has been released, it will be loaded back from
+ * the packet frame contents.
+ *
+ * @param packet Packet with SIP protocol data
+ * @return payload reference (must be unreferenced) or NULL
+ */
+GBytes *
+packet_sip_payload(const Packet *packet);
+
+/**
+ * @brief Release SIP payload memory if it can be loaded from packet frame
+ *
+ * Only payloads contained in a single frame packet can be released, the
+ * rest of payloads (reassembled or decrypted) are kept in memory.
+ *
+ * @param packet Packet with SIP protocol data
+ * @return TRUE if payload no longer references frame contents, FALSE otherwise
+ */
+gboolean
+packet_sip_payload_release(Packet *packet);
+
 const gchar *
 packet_sip_method_str(const Packet *packet);
 
@@ -122,12 +176,37 @@ packet_sip_is_request(const Packet *packet);
 guint64
 packet_sip_cseq(const Packet *packet);
 
+guint64
+packet_sip_payload_hash(const Packet *packet);
+
+gsize
+packet_sip_payload_len(const Packet *packet);
+
 gboolean
 packet_sip_initial_transaction(const Packet *packet);
 
 const gchar *
 packet_sip_auth_data(const Packet *packet);
 
+const gchar *
+packet_sip_callid(const Packet *packet);
+
+const gchar *
+packet_sip_xcallid(const Packet *packet);
+
+/**
+ * @brief Get the value of an indexed SIP header
+ *
+ * Header value is extracted from the payload using the position stored
+ * by the dissector, without parsing the payload again.
+ *
+ * @param packet Packet with SIP protocol data
+ * @param header Indexed header
+ * @return allocated header value or NULL if not present
+ */
+gchar *
+packet_sip_header(const Packet *packet, enum PacketSipHeader header);
+
 PacketSipData *
 packet_sip_data(const Packet *packet);
 
@@ -34,6 +34,7 @@
 #include "capture/capture.h"
 #include "packet_ip.h"
 #include "packet_tcp.h"
+#include "storage/storage.h"
 
 G_DEFINE_TYPE(PacketDissectorTcp, packet_dissector_tcp, PACKET_TYPE_DISSECTOR)
 
@@ -101,14 +102,14 @@ packet_tcp_assembly_hashkey(PacketTcpSegment *segment)
 }
 
 static PacketTcpSegment *
-packet_tcp_segment_new(Packet *packet, GBytes *data)
+packet_tcp_segment_new(Packet *packet, GBytesView data)
 {
     // Reserve memory for storing segment information
     PacketTcpSegment *segment = g_malloc(sizeof(PacketTcpSegment));
     // Store packet information
     segment->packet = packet_ref(packet);
     // Set segment payload for future reassembly
-    segment->data = g_bytes_ref(data);
+    segment->data = g_bytes_view_to_bytes(data);
     return segment;
 }
 
@@ -135,6 +136,7 @@ static void
 packet_tcp_stream_free(PacketTcpStream *stream)
 {
     g_free(stream->hashkey);
+    storage_memory_account(STORAGE_MEMORY_REASSEMBLY, -(gssize) g_byte_array_len(stream->data));
     g_byte_array_free(stream->data, TRUE);
     g_ptr_array_free(stream->segments, TRUE);
     g_free(stream);
@@ -172,6 +174,7 @@ packet_tcp_stream_add_segment(PacketTcpStream *stream, PacketTcpSegment *segment
         g_bytes_get_data(segment->data, NULL),
         g_bytes_get_size(segment->data)
     );
+    storage_memory_account(STORAGE_MEMORY_REASSEMBLY, g_bytes_get_size(segment->data));
 }
 
 static PacketTcpStream *
@@ -184,23 +187,23 @@ packet_dissector_tcp_find_stream(PacketDissectorTcp *priv, PacketTcpSegment *seg
     return g_hash_table_lookup(priv->assembly, hashkey);
 }
 
-static GBytes *
-packet_dissector_tcp_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_tcp_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     // Get TCP dissector information
-    g_return_val_if_fail(PACKET_DISSECTOR_IS_TCP(self), NULL);
+    g_return_val_if_fail(PACKET_DISSECTOR_IS_TCP(self), G_BYTES_VIEW_NONE);
     PacketDissectorTcp *dissector = PACKET_DISSECTOR_TCP(self);
 
     // Get Packet IP protocol information
     PacketIpData *ipdata = packet_ip_data(packet);
-    g_return_val_if_fail(ipdata != NULL, NULL);
+    g_return_val_if_fail(ipdata != NULL, G_BYTES_VIEW_NONE);
 
     // Is this a IP/TCP packet?
     if (ipdata->protocol != IPPROTO_TCP)
         return data;
 
     // Get TCP Header content
-    struct tcphdr *tcp = (struct tcphdr *) g_bytes_get_data(data, NULL);
+    struct tcphdr *tcp = (struct tcphdr *) g_bytes_view_get_data(data);
 
     // TCP packet data
     PacketTcpData *tcp_data = g_malloc0(sizeof(PacketTcpData));
@@ -227,7 +230,7 @@ packet_dissector_tcp_dissect(PacketDissector *self, Packet *packet, GBytes *data
     packet_set_protocol_data(packet, PACKET_PROTO_TCP, tcp_data);
 
     // Remove TCP header length
-    data = g_bytes_offset(data, tcp_data->off);
+    data = g_bytes_view_offset(data, tcp_data->off);
 
     // Create new segment for this stream
     PacketTcpSegment *segment = packet_tcp_segment_new(packet, data);
@@ -254,17 +257,23 @@ packet_dissector_tcp_dissect(PacketDissector *self, Packet *packet, GBytes *data
     packet->frames = packet_tcp_stream_take_frames(stream);
 
     // Check if this packet is interesting
-    GByteArray *stream_data = g_byte_array_copy(stream->data);
-    guint stream_len = g_byte_array_len(stream_data);
-    GBytes *pending = packet_dissector_next(
+    g_autoptr(GBytes) stream_data = g_bytes_new(stream->data->data, stream->data->len);
+    guint stream_len = g_byte_array_len(stream->data);
+    GBytesView pending = packet_dissector_next(
         self,
         packet,
-        g_byte_array_free_to_bytes(stream_data)
+        g_bytes_view(stream_data)
     );
 
-    if (pending != NULL) {
+    // Keep not dissected stream data
+    if (!g_bytes_view_is_none(pending)) {
+        storage_memory_account(
+            STORAGE_MEMORY_REASSEMBLY,
+            (gssize) g_bytes_view_get_size(pending) - (gssize) g_byte_array_len(stream->data)
+        );
         g_byte_array_free(stream->data, TRUE);
-        stream->data = g_bytes_unref_to_array(pending);
+        stream->data = g_byte_array_sized_new(g_bytes_view_get_size(pending));
+        g_byte_array_append(stream->data, g_bytes_view_get_data(pending), g_bytes_view_get_size(pending));
     }
 
     // Not interesting stream
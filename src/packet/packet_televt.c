@@ -92,16 +92,16 @@ packet_televt_data(const Packet *packet)
     return televt;
 }
 
-static GBytes *
-packet_dissector_televt_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_televt_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     gchar value = ' ';
 
     // Not enough data for a DTMF packet
-    if (g_bytes_get_size(data) != sizeof(PacketTelEvtHdr))
+    if (g_bytes_view_get_size(data) != sizeof(PacketTelEvtHdr))
         return data;
 
-    PacketTelEvtHdr *hdr = (PacketTelEvtHdr *) g_bytes_get_data(data, NULL);
+    PacketTelEvtHdr *hdr = (PacketTelEvtHdr *) g_bytes_view_get_data(data);
     // Convert telephony event to value
     for (guint i = 0; i < DTMF_MAX_EVENT; i++) {
         if (hdr->event == event_codes[i].code) {
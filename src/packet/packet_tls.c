@@ -462,12 +462,12 @@ packet_dissector_tls_connection_find(PacketDissectorTls *dissector, Address src,
 
 
 static GBytes *
-packet_tls_process_record_decode(SSLConnection *conn, GBytes *data)
+packet_tls_process_record_decode(SSLConnection *conn, GBytesView data)
 {
     gcry_cipher_hd_t *evp;
     guint8 nonce[16] = { 0 };
 
-    packet_tls_debug_print_hex("Ciphertext", g_bytes_get_data(data, NULL), g_bytes_get_size(data));
+    packet_tls_debug_print_hex("Ciphertext", g_bytes_view_get_data(data), g_bytes_view_get_size(data));
 
     if (conn->direction == 0) {
         evp = &conn->client_cipher_ctx;
@@ -477,29 +477,29 @@ packet_tls_process_record_decode(SSLConnection *conn, GBytes *data)
 
     if (conn->cipher_data.mode == MODE_CBC) {
         // TLS 1.1 and later extract explicit IV
-        if (conn->version >= 2 && g_bytes_get_size(data) > 16) {
-            gcry_cipher_setiv(*evp, g_bytes_get_data(data, NULL), 16);
-            data = g_bytes_offset(data, 16);
+        if (conn->version >= 2 && g_bytes_view_get_size(data) > 16) {
+            gcry_cipher_setiv(*evp, g_bytes_view_get_data(data), 16);
+            data = g_bytes_view_offset(data, 16);
         }
     }
 
     if (conn->cipher_data.mode == MODE_GCM) {
         if (conn->direction == 0) {
             memcpy(nonce, conn->key_material.client_write_IV, conn->cipher_data.ivblock);
-            memcpy(nonce + conn->cipher_data.ivblock, g_bytes_get_data(data, NULL), 8);
+            memcpy(nonce + conn->cipher_data.ivblock, g_bytes_view_get_data(data), 8);
             nonce[15] = 2;
         } else {
             memcpy(nonce, conn->key_material.server_write_IV, conn->cipher_data.ivblock);
-            memcpy(nonce + conn->cipher_data.ivblock, g_bytes_get_data(data, NULL), 8);
+            memcpy(nonce + conn->cipher_data.ivblock, g_bytes_view_get_data(data), 8);
             nonce[15] = 2;
         }
         gcry_cipher_setctr(*evp, nonce, sizeof(nonce));
-        data = g_bytes_offset(data, 8);
+        data = g_bytes_view_offset(data, 8);
     }
 
-    GByteArray *out = g_byte_array_sized_new(g_bytes_get_size(data));
-    g_byte_array_set_size(out, g_bytes_get_size(data));
-    gcry_cipher_decrypt(*evp, out->data, out->len, g_bytes_get_data(data, NULL), g_bytes_get_size(data));
+    GByteArray *out = g_byte_array_sized_new(g_bytes_view_get_size(data));
+    g_byte_array_set_size(out, g_bytes_view_get_size(data));
+    gcry_cipher_decrypt(*evp, out->data, out->len, g_bytes_view_get_data(data), g_bytes_view_get_size(data));
     packet_tls_debug_print_hex("Plaintext", out->data, out->len);
 
     // Strip mac from the decoded data
@@ -525,14 +525,14 @@ packet_tls_process_record_decode(SSLConnection *conn, GBytes *data)
 
 
 static gboolean
-packet_tls_record_handshake_is_ssl2(G_GNUC_UNUSED SSLConnection *conn, GBytes *data)
+packet_tls_record_handshake_is_ssl2(G_GNUC_UNUSED SSLConnection *conn, GBytesView data)
 {
-    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(!g_bytes_view_is_none(data), FALSE);
 
-    const guint8 *content = g_bytes_get_data(data, NULL);
+    const guint8 *content = g_bytes_view_get_data(data);
 
     // This magic belongs to wireshark people <3
-    if (g_bytes_get_size(data) < 3) return 0;
+    if (g_bytes_view_get_size(data) < 3) return 0;
     // v2 client hello should start this way
     if (content[0] != 0x80) return 0;
     // v2 client hello msg type
@@ -541,8 +541,8 @@ packet_tls_record_handshake_is_ssl2(G_GNUC_UNUSED SSLConnection *conn, GBytes *d
     return 1;
 }
 
-static GBytes *
-packet_tls_process_record_ssl2(SSLConnection *conn, GBytes *data)
+static GBytesView
+packet_tls_process_record_ssl2(SSLConnection *conn, GBytesView data)
 {
     int record_len_len;
     uint32_t record_len;
@@ -551,11 +551,11 @@ packet_tls_process_record_ssl2(SSLConnection *conn, GBytes *data)
     int flen;
 
     // No record data here!
-    if (g_bytes_get_size(data) == 0)
-        return NULL;
+    if (g_bytes_view_get_size(data) == 0)
+        return G_BYTES_VIEW_NONE;
 
     // Record header length
-    const guint8 *content = g_bytes_get_data(data, NULL);
+    const guint8 *content = g_bytes_view_get_data(data);
     record_len_len = (content[0] & 0x80) ? 2 : 3;
 
     // Two bytes SSLv2 record length field
@@ -595,11 +595,11 @@ packet_tls_process_record_ssl2(SSLConnection *conn, GBytes *data)
 }
 
 static gboolean
-packet_tls_process_record_client_hello(SSLConnection *conn, GBytes *data)
+packet_tls_process_record_client_hello(SSLConnection *conn, GBytesView data)
 {
     // Store client random
     struct ClientHello clienthello;
-    memcpy(&clienthello, g_bytes_get_data(data, NULL), sizeof(struct ClientHello));
+    memcpy(&clienthello, g_bytes_view_get_data(data), sizeof(struct ClientHello));
 
     // Store client random
     memcpy(&conn->client_random, &clienthello.random, sizeof(struct Random));
@@ -616,16 +616,16 @@ packet_tls_process_record_client_hello(SSLConnection *conn, GBytes *data)
 }
 
 static gboolean
-packet_tls_process_record_server_hello(SSLConnection *conn, GBytes *data)
+packet_tls_process_record_server_hello(SSLConnection *conn, GBytesView data)
 {
     // Store server random
     struct ServerHello serverhello;
-    memcpy(&serverhello, g_bytes_get_data(data, NULL), sizeof(struct ServerHello));
+    memcpy(&serverhello, g_bytes_view_get_data(data), sizeof(struct ServerHello));
 
     memcpy(&conn->server_random, &serverhello.random, sizeof(struct Random));
 
     // Get the selected cipher
-    const guint8 *content = g_bytes_get_data(data, NULL);
+    const guint8 *content = g_bytes_view_get_data(data);
     memcpy(&conn->cipher_suite,
            content + sizeof(struct ServerHello) + serverhello.session_id_length,
            sizeof(guint16));
@@ -635,10 +635,10 @@ packet_tls_process_record_server_hello(SSLConnection *conn, GBytes *data)
 }
 
 static gboolean
-packet_tls_process_record_key_exchange(SSLConnection *conn, GBytes *data)
+packet_tls_process_record_key_exchange(SSLConnection *conn, GBytesView data)
 {
     // Decrypt PreMasterKey
-    struct ClientKeyExchange *clientkeyex = (struct ClientKeyExchange *) g_bytes_get_data(data, NULL);
+    struct ClientKeyExchange *clientkeyex = (struct ClientKeyExchange *) g_bytes_view_get_data(data);
 
     gnutls_datum_t exkeys, pms;
     exkeys.size = UINT16_INT(clientkeyex->length);
@@ -751,12 +751,12 @@ packet_tls_process_record_key_exchange(SSLConnection *conn, GBytes *data)
 }
 
 static gboolean
-packet_tls_process_record_handshake(SSLConnection *conn, GBytes *data)
+packet_tls_process_record_handshake(SSLConnection *conn, GBytesView data)
 {
     // Get Handshake data
     struct Handshake handshake;
-    memcpy(&handshake, g_bytes_get_data(data, NULL), sizeof(struct Handshake));
-    data = g_bytes_offset(data, sizeof(struct Handshake));
+    memcpy(&handshake, g_bytes_view_get_data(data), sizeof(struct Handshake));
+    data = g_bytes_view_offset(data, sizeof(struct Handshake));
 
     if (UINT24_INT(handshake.length) < 0) {
         return FALSE;
@@ -785,36 +785,40 @@ packet_tls_process_record_handshake(SSLConnection *conn, GBytes *data)
     return TRUE;
 }
 
-static GBytes *
-packet_tls_process_record(SSLConnection *conn, GBytes *data, GBytes **out)
+static GBytesView
+packet_tls_process_record(SSLConnection *conn, GBytesView data, GBytes **out)
 {
     // No record data here!
-    if (g_bytes_get_size(data) == 0)
+    if (g_bytes_view_get_size(data) == 0)
         return data;
 
     // Get Record data
     struct TLSPlaintext record;
-    memcpy(&record, g_bytes_get_data(data, NULL), sizeof(struct TLSPlaintext));
-    data = g_bytes_offset(data, sizeof(struct TLSPlaintext));
+    memcpy(&record, g_bytes_view_get_data(data), sizeof(struct TLSPlaintext));
+    data = g_bytes_view_offset(data, sizeof(struct TLSPlaintext));
 
     // Process record fragment
     if (UINT16_INT(record.length) > 0) {
-        if (UINT16_INT(record.length) > (int) g_bytes_get_size(data)) {
-            return g_bytes_offset(data, g_bytes_get_size(data));
+        if (UINT16_INT(record.length) > (int) g_bytes_view_get_size(data)) {
+            return g_bytes_view_offset(data, g_bytes_view_get_size(data));
         }
-        // TLSPlaintext fragment pointer
-        g_autoptr(GBytes) fragment = g_bytes_new(g_bytes_get_data(data, NULL), g_bytes_get_size(data));
-        data = g_bytes_offset(data, UINT16_INT(record.length));
+        // TLSPlaintext fragment
+        GBytesView fragment = g_bytes_view_set_size(data, UINT16_INT(record.length));
+        data = g_bytes_view_offset(data, UINT16_INT(record.length));
 
         switch (record.type) {
             case HANDSHAKE:
                 // Decode before parsing
                 if (conn->encrypted) {
-                    fragment = packet_tls_process_record_decode(conn, fragment);
+                    g_autoptr(GBytes) decoded = packet_tls_process_record_decode(conn, fragment);
+                    // Hanshake Record, Try to get MasterSecret data
+                    if (!packet_tls_process_record_handshake(conn, g_bytes_view(decoded)))
+                        return G_BYTES_VIEW_NONE;
+                    break;
                 }
                 // Hanshake Record, Try to get MasterSecret data
                 if (!packet_tls_process_record_handshake(conn, fragment))
-                    return NULL;
+                    return G_BYTES_VIEW_NONE;
                 break;
             case CHANGE_CIPHER_SPEC:
                 // From now on, this connection will be encrypted using MasterSecret
@@ -824,6 +828,8 @@ packet_tls_process_record(SSLConnection *conn, GBytes *data, GBytes **out)
             case APPLICATION_DATA:
                 if (conn->encrypted) {
                     // Decrypt application data using MasterSecret
+                    if (*out != NULL)
+                        g_bytes_unref(*out);
                     *out = packet_tls_process_record_decode(conn, fragment);
                 }
                 break;
@@ -835,14 +841,14 @@ packet_tls_process_record(SSLConnection *conn, GBytes *data, GBytes **out)
     return data;
 }
 
-static GBytes *
-packet_dissector_tls_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+static GBytesView
+packet_dissector_tls_dissect(PacketDissector *self, Packet *packet, GBytesView data)
 {
     SSLConnection *conn = NULL;
-    GBytes *out = NULL;
+    g_autoptr(GBytes) out = NULL;
 
     // Get TLS dissector information
-    g_return_val_if_fail(PACKET_DISSECTOR_IS_TLS(self), NULL);
+    g_return_val_if_fail(PACKET_DISSECTOR_IS_TLS(self), G_BYTES_VIEW_NONE);
     PacketDissectorTls *dissector = PACKET_DISSECTOR_TLS(self);
 
     // Get manager information
@@ -855,7 +861,7 @@ packet_dissector_tls_dissect(PacketDissector *self, Packet *packet, GBytes *data
 
     // Get TCP/IP data from this packet
     PacketTcpData *tcpdata = packet_get_protocol_data(packet, PACKET_PROTO_TCP);
-    g_return_val_if_fail(tcpdata != NULL, NULL);
+    g_return_val_if_fail(tcpdata != NULL, G_BYTES_VIEW_NONE);
 
     // Get packet addresses
     Address src = packet_src_address(packet);
@@ -882,16 +888,15 @@ packet_dissector_tls_dissect(PacketDissector *self, Packet *packet, GBytes *data
             case TCP_STATE_ESTABLISHED:
                 // Check if we have a SSLv2 Handshake
                 if (packet_tls_record_handshake_is_ssl2(conn, data)) {
-                    out = packet_tls_process_record_ssl2(conn, data);
-                    if (out == NULL) {
+                    if (g_bytes_view_is_none(packet_tls_process_record_ssl2(conn, data))) {
                         dissector->connections = g_slist_remove(dissector->connections, conn);
                         packet_tls_connection_destroy(conn);
                     }
                 } else {
                     // Process data segment!
-                    while (g_bytes_get_size(data) > 0) {
+                    while (g_bytes_view_get_size(data) > 0) {
                         data = packet_tls_process_record(conn, data, &out);
-                        if (data == NULL) {
+                        if (g_bytes_view_is_none(data)) {
                             dissector->connections = g_slist_remove(dissector->connections, conn);
                             packet_tls_connection_destroy(conn);
                             break;
@@ -899,9 +904,11 @@ packet_dissector_tls_dissect(PacketDissector *self, Packet *packet, GBytes *data
                     }
                 }
 
-                // This seems a SIP TLS packet ;-)
+                // This seems a SIP TLS packet ;-) (decoded data is only valid during this call)
                 if (out != NULL && g_bytes_get_size(out) > 0) {
-                    return packet_dissector_next(self, packet, out);
+                    if (g_bytes_view_is_none(packet_dissector_next(self, packet, g_bytes_view(out)))) {
+                        return G_BYTES_VIEW_NONE;
+                    }
                 }
                 break;
             case TCP_STATE_FIN:
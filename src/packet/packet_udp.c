@@ -34,10 +34,14 @@
 #include "glib-extra/glib.h"
 #include "packet_ip.h"
 #include "packet.h"
+#include "packet_pool.h"
 #include "packet_udp.h"
 
 G_DEFINE_TYPE(PacketDissectorUdp, packet_dissector_udp, PACKET_TYPE_DISSECTOR)
 
+//! Recycled UDP protocol data structures
+static PacketDataPool udp_data_pool = PACKET_DATA_POOL_INIT(PacketUdpData, 4096);
+
 PacketUdpData *
 packet_udp_data(const Packet *packet)
 {
@@ -45,10 +49,18 @@ packet_udp_data(const Packet *packet)
     return packet_get_protocol_data(packet, PACKET_PROTO_UDP);
 }
 
-static GBytes *
-packet_dissector_udp_dissect(PacketDissector *self, Packet *packet, GBytes *data)
+PacketUdpData *
+packet_udp_data_new()
 {
-    struct udphdr *udp = (struct udphdr *) g_bytes_get_data(data, NULL);
+    PacketUdpData *udp_data = packet_data_pool_alloc(&udp_data_pool);
+    udp_data->proto.id = PACKET_PROTO_UDP;
+    return udp_data;
+}
+
+static GBytesView
+packet_dissector_udp_dissect(PacketDissector *self, Packet *packet, GBytesView data)
+{
+    struct udphdr *udp = (struct udphdr *) g_bytes_view_get_data(data);
     uint16_t udp_off = sizeof(struct udphdr);
 
     //! Is this a IP/TCP packet?
@@ -58,12 +70,11 @@ packet_dissector_udp_dissect(PacketDissector *self, Packet *packet, GBytes *data
         return data;
 
     // Check payload can contain an UDP header
-    if (g_bytes_get_size(data) < udp_off)
-        return NULL;
+    if (g_bytes_view_get_size(data) < udp_off)
+        return G_BYTES_VIEW_NONE;
 
     // UDP packet data
-    PacketUdpData *udp_data = g_malloc0(sizeof(PacketUdpData));
-    udp_data->proto.id = PACKET_PROTO_UDP;
+    PacketUdpData *udp_data = packet_udp_data_new();
 
     // Set packet ports
 #ifdef __FAVOR_BSD
@@ -78,7 +89,7 @@ packet_dissector_udp_dissect(PacketDissector *self, Packet *packet, GBytes *data
     packet_set_protocol_data(packet, PACKET_PROTO_UDP, udp_data);
 
     // Get pending payload
-    data = g_bytes_offset(data, udp_off);
+    data = g_bytes_view_offset(data, udp_off);
 
     // Call next dissector
     return packet_dissector_next(self, packet, data);
@@ -89,7 +100,7 @@ packet_dissector_udp_free_data(Packet *packet)
 {
     PacketUdpData *udp_data = packet_udp_data(packet);
     g_return_if_fail(udp_data != NULL);
-    g_free(udp_data);
+    packet_data_pool_release(&udp_data_pool, udp_data);
 }
 
 static void
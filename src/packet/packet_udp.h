@@ -62,6 +62,17 @@ struct _PacketUdpData
 PacketUdpData *
 packet_udp_data(const Packet *packet);
 
+/**
+ * @brief Create a new UDP protocol data structure
+ *
+ * Structures are taken from a shared pool and returned to it when
+ * the packet protocol data is freed.
+ *
+ * @return Pointer to a zeroed PacketUdpData
+ */
+PacketUdpData *
+packet_udp_data_new();
+
 /**
  * @brief Create an UDP parser
  *
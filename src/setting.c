@@ -478,6 +478,9 @@ settings_init(SettingOpts options)
     settings_add_setting(SETTING_PACKET_RTCP, setting_bool_new(TRUE));
     settings_add_setting(SETTING_PACKET_TELEVT, setting_bool_new(TRUE));
     settings_add_setting(SETTING_STORAGE_MEMORY_LIMIT, setting_string_new("250M"));
+    settings_add_setting(SETTING_STORAGE_COLD_AGE, setting_number_new(0));
+    settings_add_setting(SETTING_STORAGE_PAYLOAD_INDEX, setting_bool_new(FALSE));
+    settings_add_setting(SETTING_STORAGE_PAYLOAD_INDEX_LIMIT, setting_string_new("64M"));
     settings_add_setting(SETTING_STORAGE_RTP, setting_bool_new(FALSE));
     settings_add_setting(SETTING_STORAGE_MODE,
                          setting_enum_new(SETTING_STORAGE_MODE_MEMORY, SETTING_TYPE_STORAGE_MODE));
@@ -101,6 +101,9 @@ typedef struct _SettingStorage SettingStorage;
 #define SETTING_STORAGE_RTP             "storage.rtp"
 #define SETTING_STORAGE_MODE            "storage.mode"
 #define SETTING_STORAGE_MEMORY_LIMIT    "storage.memory_limit"
+#define SETTING_STORAGE_COLD_AGE        "storage.cold_age"
+#define SETTING_STORAGE_PAYLOAD_INDEX   "storage.payload_index"
+#define SETTING_STORAGE_PAYLOAD_INDEX_LIMIT "storage.payload_index_limit"
 #define SETTING_STORAGE_ROTATE          "storage.rotate"
 #define SETTING_STORAGE_COMPLETE_DLG    "storage.complete"
 #define SETTING_STORAGE_CALLS           "storage.calls"
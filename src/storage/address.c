@@ -35,25 +35,18 @@
 #include <arpa/inet.h>
 #include "glib-extra/glib.h"
 #include "address.h"
+#include "intern.h"
 
 gboolean
 addressport_equals(const Address addr1, const Address addr2)
 {
-    if (addr1.ip == NULL && addr2.ip == NULL) {
-        return TRUE;
-    }
-
-    return addr1.port == addr2.port && g_strcmp0(addr1.ip, addr2.ip) == 0;
+    return addr1.port == addr2.port && addr1.ip == addr2.ip;
 }
 
 gboolean
 address_equals(const Address addr1, const Address addr2)
 {
-    if (addr1.ip == NULL && addr2.ip == NULL) {
-        return TRUE;
-    }
-
-    return g_strcmp0(addr1.ip, addr2.ip) == 0;
+    return addr1.ip == addr2.ip;
 }
 
 gboolean
@@ -164,14 +157,14 @@ address_strip_port(Address address)
 void
 address_free(Address address)
 {
-    g_free(address.ip);
+    intern_unref(address.ip);
 }
 
 Address
 address_new(const gchar *ip, guint16 port)
 {
     Address address = ADDRESS_ZERO;
-    address.ip = g_strdup(ip);
+    address.ip = intern_string(ip);
     address.port = port;
     return address;
 }
@@ -59,8 +59,8 @@ typedef struct _Address Address;
  */
 struct _Address
 {
-    //! IP address
-    gchar *ip;
+    //! IP address (interned, compared by pointer)
+    const gchar *ip;
     //! Port
     guint16 port;
 };
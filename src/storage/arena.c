@@ -0,0 +1,124 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file arena.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in arena.h
+ *
+ */
+#include "config.h"
+#include <string.h>
+#include <glib.h>
+#include "arena.h"
+#include "storage.h"
+
+//! Round a size to the allocation alignment
+#define ARENA_ALIGN(size) (((size) + G_MEM_ALIGN - 1) & ~((gsize) G_MEM_ALIGN - 1))
+//! Chunk header size, chunk data starts after it
+#define ARENA_CHUNK_HEADER ARENA_ALIGN(sizeof(ArenaChunk))
+
+/**
+ * @brief Allocate a new chunk with the given data size
+ */
+static ArenaChunk *
+arena_chunk_new(Arena *arena, gsize size)
+{
+    ArenaChunk *chunk = g_malloc(ARENA_CHUNK_HEADER + size);
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->size += ARENA_CHUNK_HEADER + size;
+    storage_memory_account(STORAGE_MEMORY_CALLS, (gssize) (ARENA_CHUNK_HEADER + size));
+    return chunk;
+}
+
+Arena *
+arena_new()
+{
+    Arena *arena = g_malloc0(sizeof(Arena));
+    arena->chunks = arena_chunk_new(arena, ARENA_CHUNK_MIN);
+    return arena;
+}
+
+void
+arena_free(Arena *arena)
+{
+    g_return_if_fail(arena != NULL);
+
+    for (ArenaChunk *chunk = arena->chunks, *next; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        g_free(chunk);
+    }
+
+    storage_memory_account(STORAGE_MEMORY_CALLS, -(gssize) arena->size);
+    g_free(arena);
+}
+
+gpointer
+arena_alloc0(Arena *arena, gsize size)
+{
+    g_return_val_if_fail(arena != NULL, NULL);
+
+    size = ARENA_ALIGN(MAX(size, 1));
+    ArenaChunk *chunk = arena->chunks;
+
+    if (chunk->used + size > chunk->size) {
+        if (size > ARENA_CHUNK_MAX / 4) {
+            // Big allocations get their own chunk, keep using current one
+            ArenaChunk *big = arena_chunk_new(arena, size);
+            big->next = chunk->next;
+            chunk->next = big;
+            chunk = big;
+        } else {
+            // Each new chunk doubles the previous one up to the maximum size
+            gsize chunk_size = MIN(arena->chunks->size * 2, ARENA_CHUNK_MAX);
+            chunk = arena_chunk_new(arena, MAX(size, chunk_size));
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+    }
+
+    gpointer ptr = (guint8 *) chunk + ARENA_CHUNK_HEADER + chunk->used;
+    chunk->used += size;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+gchar *
+arena_strdup(Arena *arena, const gchar *str)
+{
+    if (str == NULL)
+        return NULL;
+
+    gsize len = strlen(str) + 1;
+    gchar *copy = arena_alloc0(arena, len);
+    memcpy(copy, str, len);
+    return copy;
+}
+
+gsize
+arena_size(const Arena *arena)
+{
+    return arena->size;
+}
@@ -0,0 +1,119 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file arena.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage grouped memory allocations
+ *
+ * An arena serves small allocations from larger memory chunks. Objects
+ * allocated in an arena can not be freed individually, all of them are
+ * released at once when the arena is freed.
+ *
+ */
+
+#ifndef __SNGREP_ARENA_H
+#define __SNGREP_ARENA_H
+
+#include <glib.h>
+
+//! Size of the first arena chunk
+#define ARENA_CHUNK_MIN (1024)
+//! Maximum size of arena chunks (except for bigger allocations)
+#define ARENA_CHUNK_MAX (16 * 1024)
+
+//! Shorter declaration of arena structures
+typedef struct _Arena Arena;
+typedef struct _ArenaChunk ArenaChunk;
+
+/**
+ * @brief Memory chunk of an arena
+ */
+struct _ArenaChunk
+{
+    //! Next chunk in the arena
+    ArenaChunk *next;
+    //! Chunk data size
+    gsize size;
+    //! Chunk used data size
+    gsize used;
+};
+
+/**
+ * @brief Group of memory chunks released together
+ */
+struct _Arena
+{
+    //! Allocated chunks (first one is the current)
+    ArenaChunk *chunks;
+    //! Total allocated memory of this arena
+    gsize size;
+};
+
+/**
+ * @brief Create a new empty arena
+ *
+ * @return new allocated arena
+ */
+Arena *
+arena_new();
+
+/**
+ * @brief Release all arena memory
+ *
+ * All objects allocated in the arena are released.
+ *
+ * @param arena Arena to be freed
+ */
+void
+arena_free(Arena *arena);
+
+/**
+ * @brief Allocate zero-filled memory in the arena
+ *
+ * @param arena Arena to allocate memory from
+ * @param size Requested memory size
+ * @return pointer to allocated memory
+ */
+gpointer
+arena_alloc0(Arena *arena, gsize size);
+
+/**
+ * @brief Copy a string into the arena
+ *
+ * @param arena Arena to allocate memory from
+ * @param str String to copy (can be NULL)
+ * @return copied string or NULL
+ */
+gchar *
+arena_strdup(Arena *arena, const gchar *str);
+
+/**
+ * @brief Get total allocated memory of the arena
+ *
+ * @param arena Arena structure
+ * @return allocated size in bytes
+ */
+gsize
+arena_size(const Arena *arena);
+
+#endif /* __SNGREP_ARENA_H */
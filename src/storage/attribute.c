@@ -27,13 +27,25 @@
  *
  */
 #include "config.h"
+#include <string.h>
 #include <glib.h>
 #include "glib-extra/glib.h"
 #include "attribute.h"
 #include "packet/packet_sip.h"
 #include "tui/tui.h"
 
+//! Registered attributes indexed by their identifier
 static GPtrArray *attributes = NULL;
+//! Registered attributes indexed by their name
+static GHashTable *attributes_names = NULL;
+//! Combined expression of all regular expression attributes
+static GRegex *attributes_regex = NULL;
+//! Attributes included in the combined expression
+static GPtrArray *attributes_regex_list = NULL;
+
+//! Flags used for attribute regular expressions
+#define ATTR_REGEX_COMPILE_FLAGS \
+    (G_REGEX_OPTIMIZE | G_REGEX_CASELESS | G_REGEX_NEWLINE_CRLF | G_REGEX_MULTILINE)
 
 Attribute *
 attribute_new(gchar *name, gchar *title, gchar *desc, gint length)
@@ -61,6 +73,28 @@ attribute_set_getter_func(Attribute *attr, AttributeGetterFunc func)
     attr->getterFunc = func;
 }
 
+void
+attribute_set_typed_getter_func(Attribute *attr, enum AttributeType type, AttributeTypedGetterFunc func)
+{
+    g_return_if_fail(attr != NULL);
+    attr->type = type;
+    attr->typedGetterFunc = func;
+    attr->getterFunc = NULL;
+}
+
+void
+attribute_set_format_func(Attribute *attr, AttributeFormatFunc func)
+{
+    g_return_if_fail(attr != NULL);
+    attr->formatFunc = func;
+}
+
+enum AttributeType
+attribute_get_type(Attribute *attr)
+{
+    return attr->type;
+}
+
 void
 attribute_set_mutable(Attribute *attr, gboolean mutable)
 {
@@ -110,16 +144,41 @@ attribute_set_length(Attribute *attr, gint length)
     attr->length = length;
 }
 
+/**
+ * @brief Add a new attribute to the attributes list
+ *
+ * Attribute identifier is assigned in registration order.
+ *
+ * @param attr Attribute to register
+ */
+static void
+attribute_register(Attribute *attr)
+{
+    attr->id = g_ptr_array_len(attributes);
+    g_ptr_array_add(attributes, attr);
+    g_hash_table_insert(attributes_names, attr->name, attr);
+}
+
 Attribute *
 attribute_find_by_name(const gchar *name)
 {
-    for (guint i = 0; i < g_ptr_array_len(attributes); i++) {
-        Attribute *attr = g_ptr_array_index(attributes, i);
-        if (g_strcmp0(name, attr->name) == 0) {
-            return attr;
-        }
-    }
-    return NULL;
+    if (name == NULL)
+        return NULL;
+    return g_hash_table_lookup(attributes_names, name);
+}
+
+Attribute *
+attribute_find_by_id(guint id)
+{
+    if (id >= g_ptr_array_len(attributes))
+        return NULL;
+    return g_ptr_array_index(attributes, id);
+}
+
+guint
+attribute_count()
+{
+    return g_ptr_array_len(attributes);
 }
 
 gint
@@ -136,12 +195,53 @@ attribute_get_color(Attribute *attr, const gchar *value)
     return 0;
 }
 
+/**
+ * @brief Convert a typed value to text using its type default format
+ */
+static gchar *
+attribute_format_typed_value(Attribute *attr, const AttributeTypedValue *value)
+{
+    gchar out[20];
+
+    switch (attr->type) {
+        case ATTR_TYPE_INTEGER:
+            return g_strdup_printf("%" G_GINT64_FORMAT, value->number);
+        case ATTR_TYPE_DURATION:
+            return g_strdup_printf(
+                "%" G_GINT64_FORMAT ":%02" G_GINT64_FORMAT,
+                value->number / G_USEC_PER_SEC / 60,
+                value->number / G_USEC_PER_SEC % 60
+            );
+        case ATTR_TYPE_TIMESTAMP:
+            return g_strdup(date_time_time_to_str((guint64) value->number, out));
+        case ATTR_TYPE_ADDRESS:
+            return g_strdup_printf(
+                "%s:%u",
+                address_get_ip(value->address),
+                address_get_port(value->address)
+            );
+        default:
+            return NULL;
+    }
+}
+
 gchar *
 attribute_get_value(Attribute *attr, Message *msg)
 {
     g_return_val_if_fail(msg != NULL, NULL);
     g_return_val_if_fail(attr != NULL, NULL);
 
+    if (attr->typedGetterFunc) {
+        AttributeTypedValue value = { 0 };
+        if (!attr->typedGetterFunc(attr, msg, &value))
+            return NULL;
+
+        if (attr->formatFunc) {
+            return attr->formatFunc(attr, &value);
+        }
+        return attribute_format_typed_value(attr, &value);
+    }
+
     if (attr->getterFunc) {
         return attr->getterFunc(attr, msg);
     }
@@ -149,6 +249,19 @@ attribute_get_value(Attribute *attr, Message *msg)
     return NULL;
 }
 
+gboolean
+attribute_get_typed_value(Attribute *attr, Message *msg, AttributeTypedValue *value)
+{
+    g_return_val_if_fail(msg != NULL, FALSE);
+    g_return_val_if_fail(attr != NULL, FALSE);
+    g_return_val_if_fail(value != NULL, FALSE);
+
+    if (attr->typedGetterFunc == NULL)
+        return FALSE;
+
+    return attr->typedGetterFunc(attr, msg, value);
+}
+
 gint
 attribute_color_sip_method(const gchar *value)
 {
@@ -195,30 +308,158 @@ attribute_regex_value_getter(Attribute *attr, Message *msg)
 
     g_return_val_if_fail(msg != NULL, NULL);
 
-    g_autofree gchar *payload = msg_get_payload(msg);
+    g_autoptr(GBytes) payload = msg_get_payload(msg);
     g_return_val_if_fail(payload != NULL, NULL);
 
     // Response code
     GMatchInfo *pmatch;
-    if (g_regex_match(attr->regex, payload, 0, &pmatch)) {
+    if (g_regex_match_full(attr->regex,
+                           g_bytes_get_data(payload, NULL), (gssize) g_bytes_get_size(payload),
+                           0, 0, &pmatch, NULL)) {
         ret = g_match_info_fetch_named(pmatch, "value");
     }
     g_match_info_free(pmatch);
     return ret;
 }
 
+/**
+ * @brief Get the value of a SIP header indexed by the dissector
+ *
+ * @return allocated header value or NULL if not present
+ */
 static gchar *
-attribute_getter_call_index(G_GNUC_UNUSED Attribute *attr, Message *msg)
+attribute_sip_header(Message *msg, enum PacketSipHeader header)
 {
-    Call *call = msg_get_call(msg);
-    return g_strdup_printf("%d", call->index);
+    if (!packet_has_protocol(msg->packet, PACKET_PROTO_SIP))
+        return NULL;
+
+    return packet_sip_header(msg->packet, header);
+}
+
+/**
+ * @brief Extract the URI from a From or To header value
+ *
+ * Display name and URI scheme are skipped and the URI ends before the
+ * first parameter or closing bracket.
+ *
+ * @param value From or To header value
+ * @param user_only Only return the user part of the URI
+ * @return allocated URI or NULL if header value is not valid
+ */
+static gchar *
+attribute_sip_uri(const gchar *value, gboolean user_only)
+{
+    if (value == NULL)
+        return NULL;
+
+    // Skip display name and URI scheme
+    const gchar *start = strchr(value, ':');
+    if (start == NULL)
+        return NULL;
+    start++;
+
+    gsize len = strcspn(start, (user_only) ? "@;>" : ";>");
+    if (len == 0)
+        return NULL;
+
+    return g_strndup(start, len);
+}
+
+static gchar *
+attribute_getter_msg_sipfrom(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    g_autofree gchar *value = attribute_sip_header(msg, SIP_HEADER_FROM);
+    return attribute_sip_uri(value, FALSE);
+}
+
+static gchar *
+attribute_getter_msg_sipfromuser(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    g_autofree gchar *value = attribute_sip_header(msg, SIP_HEADER_FROM);
+    return attribute_sip_uri(value, TRUE);
+}
+
+static gchar *
+attribute_getter_msg_sipto(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    g_autofree gchar *value = attribute_sip_header(msg, SIP_HEADER_TO);
+    return attribute_sip_uri(value, FALSE);
+}
+
+static gchar *
+attribute_getter_msg_siptouser(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    g_autofree gchar *value = attribute_sip_header(msg, SIP_HEADER_TO);
+    return attribute_sip_uri(value, TRUE);
+}
+
+static gchar *
+attribute_getter_msg_callid(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    if (!packet_has_protocol(msg->packet, PACKET_PROTO_SIP))
+        return NULL;
+
+    return g_strdup(packet_sip_callid(msg->packet));
+}
+
+static gchar *
+attribute_getter_msg_xcallid(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    if (!packet_has_protocol(msg->packet, PACKET_PROTO_SIP))
+        return NULL;
+
+    return g_strdup(packet_sip_xcallid(msg->packet));
 }
 
 static gchar *
-attribute_getter_call_msgcnt(G_GNUC_UNUSED Attribute *attr, Message *msg)
+attribute_getter_msg_reason(G_GNUC_UNUSED Attribute *attr, Message *msg)
+{
+    g_autofree gchar *value = attribute_sip_header(msg, SIP_HEADER_REASON);
+    if (value == NULL)
+        return NULL;
+
+    // Get quoted text parameter value
+    const gchar *start = g_strrstr(value, ";text=\"");
+    if (start == NULL)
+        return NULL;
+    start += strlen(";text=\"");
+
+    const gchar *end = strrchr(start, '"');
+    if (end == NULL || end == start)
+        return NULL;
+
+    return g_strndup(start, (gsize) (end - start));
+}
+
+static gboolean
+attribute_getter_msg_warning(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
+{
+    g_autofree gchar *header = attribute_sip_header(msg, SIP_HEADER_WARNING);
+    if (header == NULL)
+        return FALSE;
+
+    // Get warning code
+    if (strspn(header, "0123456789") == 0)
+        return FALSE;
+
+    value->number = g_ascii_strtoll(header, NULL, 10);
+    return TRUE;
+}
+
+static gboolean
+attribute_getter_call_index(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
+{
+    Call *call = msg_get_call(msg);
+    value->number = call->index;
+    return TRUE;
+}
+
+static gboolean
+attribute_getter_call_msgcnt(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
     Call *call = msg_get_call(msg);
-    return g_strdup_printf("%d", call_msg_count(call));
+    value->number = call_msg_count(call);
+    return TRUE;
 }
 
 static gchar *
@@ -228,66 +469,65 @@ attribute_getter_call_state(G_GNUC_UNUSED Attribute *attr, Message *msg)
     return g_strdup(call_state_to_str(call->state));
 }
 
-static gchar *
-attribute_getter_call_convdur(G_GNUC_UNUSED Attribute *attr, Message *msg)
+/**
+ * @brief Get the time interval between two messages
+ *
+ * @return TRUE if both messages are present
+ */
+static gboolean
+attribute_duration_value(const Message *start, const Message *end, AttributeTypedValue *value)
+{
+    if (start == NULL || end == NULL)
+        return FALSE;
+
+    value->number = (gint64) (msg_get_time(end) - msg_get_time(start));
+    return TRUE;
+}
+
+static gboolean
+attribute_getter_call_convdur(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
-    gchar value[10];
     Call *call = msg_get_call(msg);
-    return g_strdup(
-        date_time_to_duration(
-            msg_get_time(call->cstart_msg),
-            msg_get_time(call->cend_msg),
-            value)
-    );
+    return attribute_duration_value(call->cstart_msg, call->cend_msg, value);
 }
 
-static gchar *
-attribute_getter_call_totaldur(G_GNUC_UNUSED Attribute *attr, Message *msg)
+static gboolean
+attribute_getter_call_totaldur(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
-    gchar value[10];
     Call *call = msg_get_call(msg);
-    return g_strdup(
-        date_time_to_duration(
-            msg_get_time(g_ptr_array_first(call->msgs)),
-            msg_get_time(g_ptr_array_last(call->msgs)),
-            value)
+    return attribute_duration_value(
+        g_ptr_array_first(call->msgs),
+        g_ptr_array_last(call->msgs),
+        value
     );
 }
 
-static gchar *
-attribute_getter_msg_source(G_GNUC_UNUSED Attribute *attr, Message *msg)
+static gboolean
+attribute_getter_msg_source(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
-    const Address src = msg_src_address(msg);
-    return g_strdup_printf(
-        "%s:%u",
-        address_get_ip(src),
-        address_get_port(src)
-    );
+    value->address = msg_src_address(msg);
+    return TRUE;
 }
 
-static gchar *
-attribute_getter_msg_destination(G_GNUC_UNUSED Attribute *attr, Message *msg)
+static gboolean
+attribute_getter_msg_destination(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
-    const Address dst = msg_dst_address(msg);
-    return g_strdup_printf(
-        "%s:%u",
-        address_get_ip(dst),
-        address_get_port(dst)
-    );
+    value->address = msg_dst_address(msg);
+    return TRUE;
 }
 
-static gchar *
-attribute_getter_msg_date(G_GNUC_UNUSED Attribute *attr, Message *msg)
+static gboolean
+attribute_getter_msg_timestamp(G_GNUC_UNUSED Attribute *attr, Message *msg, AttributeTypedValue *value)
 {
-    gchar value[11];
-    return g_strdup(date_time_date_to_str(msg_get_time(msg), value));
+    value->number = (gint64) msg_get_time(msg);
+    return TRUE;
 }
 
 static gchar *
-attribute_getter_msg_time(G_GNUC_UNUSED Attribute *attr, Message *msg)
+attribute_format_date(G_GNUC_UNUSED Attribute *attr, const AttributeTypedValue *value)
 {
-    gchar value[16];
-    return g_strdup(date_time_time_to_str(msg_get_time(msg), value));
+    gchar out[11];
+    return g_strdup(date_time_date_to_str((guint64) value->number, out));
 }
 
 static gchar *
@@ -311,28 +551,166 @@ attribute_set_regex_pattern(Attribute *attr, const gchar *pattern)
 
     attr->regex = g_regex_new(
         attr->regexp_pattern,
-        G_REGEX_OPTIMIZE | G_REGEX_CASELESS | G_REGEX_NEWLINE_CRLF | G_REGEX_MULTILINE,
+        ATTR_REGEX_COMPILE_FLAGS,
         G_REGEX_MATCH_NEWLINE_CRLF,
         NULL
     );
 
     attr->getterFunc = attribute_regex_value_getter;
+    attr->typedGetterFunc = NULL;
+    attr->formatFunc = NULL;
+    attr->type = ATTR_TYPE_STRING;
+
+    // Combined expression must be built again
+    g_clear_pointer(&attributes_regex, g_regex_unref);
+    g_clear_pointer(&attributes_regex_list, g_ptr_array_unref);
+}
+
+/**
+ * @brief Check if an attribute pattern can be part of the combined expression
+ *
+ * Patterns referencing groups by number (backreferences, subroutine calls
+ * or recursion) would reference the wrong groups once combined.
+ *
+ * @param pattern Attribute regular expression pattern
+ * @return TRUE if pattern does not reference other groups
+ */
+static gboolean
+attribute_regex_combinable(const gchar *pattern)
+{
+    for (const gchar *c = pattern; *c != '\0'; c++) {
+        if (*c == '\\') {
+            // Numbered or named backreferences: \1, \g{1}, \k<name>
+            if (g_ascii_isdigit(c[1]) || c[1] == 'g' || c[1] == 'k')
+                return FALSE;
+            // Skip escaped character
+            if (c[1] != '\0')
+                c++;
+        } else if (c[0] == '(' && c[1] == '?') {
+            // Subroutine calls and recursion: (?1), (?+1), (?R), (?&name), (?P>name), (?P=name)
+            if (g_ascii_isdigit(c[2]) || c[2] == '+' || c[2] == '-' || c[2] == 'R' || c[2] == '&'
+                || (c[2] == 'P' && (c[3] == '>' || c[3] == '=')))
+                return FALSE;
+        }
+    }
+    return TRUE;
 }
 
-AttributeValue *
-attribute_value_new(Attribute *attr, gchar *value)
+/**
+ * @brief Build a single expression with all regular expression attributes
+ *
+ * Each attribute pattern is added as an alternative inside a lookahead,
+ * so matches of different attributes can overlap. The value group of
+ * each pattern is renamed after its attribute identifier. Patterns that
+ * reference groups by number are not combined.
+ *
+ * @return TRUE if combined expression is available
+ */
+static gboolean
+attribute_regex_build()
 {
-    AttributeValue *attr_value = g_malloc0(sizeof(AttributeValue));
-    attr_value->attr = attr;
-    attr_value->value = value;
-    return attr_value;
+    if (attributes_regex_list != NULL)
+        return attributes_regex != NULL;
+
+    attributes_regex_list = g_ptr_array_new();
+    g_autoptr(GString) pattern = g_string_new("(?=");
+
+    for (guint i = 0; i < g_ptr_array_len(attributes); i++) {
+        Attribute *attr = g_ptr_array_index(attributes, i);
+        if (attr->regex == NULL || attr->getterFunc != attribute_regex_value_getter)
+            continue;
+
+        // These attributes use their own expression when requested
+        if (!attribute_regex_combinable(attr->regexp_pattern))
+            continue;
+
+        g_autofree gchar *group = g_strdup_printf("(?P<attr%u>", attr->id);
+        g_autofree gchar *alternative = g_strdup(attr->regexp_pattern);
+        const gchar *value_groups[] = { "(?P<value>", "(?<value>", "(?'value'" };
+        for (guint j = 0; j < G_N_ELEMENTS(value_groups); j++) {
+            g_auto(GStrv) parts = g_strsplit(alternative, value_groups[j], -1);
+            g_free(alternative);
+            alternative = g_strjoinv(group, parts);
+        }
+
+        if (attributes_regex_list->len > 0)
+            g_string_append_c(pattern, '|');
+        g_string_append_printf(pattern, "(?:%s)", alternative);
+        g_ptr_array_add(attributes_regex_list, attr);
+    }
+    g_string_append_c(pattern, ')');
+
+    if (attributes_regex_list->len == 0)
+        return FALSE;
+
+    // If patterns can not be combined, each attribute uses its own expression
+    attributes_regex = g_regex_new(
+        pattern->str,
+        ATTR_REGEX_COMPILE_FLAGS,
+        G_REGEX_MATCH_NEWLINE_CRLF,
+        NULL
+    );
+
+    return attributes_regex != NULL;
 }
 
 void
-attribute_value_free(AttributeValue *attr_value)
+attribute_regex_scan(Message *msg)
 {
-    g_free(attr_value->value);
-    g_free(attr_value);
+    g_return_if_fail(msg != NULL);
+
+    if (!attribute_regex_build())
+        return;
+
+    g_autoptr(GBytes) payload = msg_get_payload(msg);
+    if (payload == NULL)
+        return;
+
+    guint pending = attributes_regex_list->len;
+    g_autofree gboolean *found = g_new0(gboolean, pending);
+
+    GMatchInfo *pmatch = NULL;
+    g_regex_match_full(attributes_regex,
+                       g_bytes_get_data(payload, NULL), (gssize) g_bytes_get_size(payload),
+                       0, 0, &pmatch, NULL);
+
+    const gchar *data = g_bytes_get_data(payload, NULL);
+    gssize len = (gssize) g_bytes_get_size(payload);
+
+    // Store first match of each attribute
+    while (pending > 0 && g_match_info_matches(pmatch)) {
+        gint position = -1;
+        g_match_info_fetch_pos(pmatch, 0, &position, NULL);
+
+        for (guint i = 0; i < attributes_regex_list->len; i++) {
+            Attribute *attr = g_ptr_array_index(attributes_regex_list, i);
+            if (found[i])
+                continue;
+
+            gchar group[32];
+            gint start = -1, end = -1;
+            g_snprintf(group, sizeof(group), "attr%u", attr->id);
+            if (g_match_info_fetch_named_pos(pmatch, group, &start, &end) && start != -1) {
+                msg_set_attribute(msg, attr, g_match_info_fetch_named(pmatch, group));
+                found[i] = TRUE;
+                pending--;
+                continue;
+            }
+
+            // Only the first matching alternative is captured, check the rest at this position
+            GMatchInfo *amatch = NULL;
+            if (g_regex_match_full(attr->regex, data, len, position, G_REGEX_MATCH_ANCHORED, &amatch, NULL)) {
+                msg_set_attribute(msg, attr, g_match_info_fetch_named(amatch, "value"));
+                found[i] = TRUE;
+                pending--;
+            }
+            g_match_info_free(amatch);
+        }
+        g_match_info_next(pmatch, NULL);
+    }
+    g_match_info_free(pmatch);
+
+    // Attributes without matches are not stored, their own expression is used when requested
 }
 
 GPtrArray *
@@ -353,7 +731,7 @@ attribute_from_setting(const gchar *setting, const gchar *value)
     Attribute *attribute = attribute_find_by_name(attr_data[0]);
     if (attribute == NULL) {
         attribute = attribute_new(attr_data[0], attr_data[0], attr_data[0], 20);
-        g_ptr_array_add(attributes, attribute);
+        attribute_register(attribute);
     }
 
     if (g_strcmp0(attr_data[1], "title") == 0) {
@@ -378,107 +756,113 @@ attribute_init()
 {
     Attribute *attribute = NULL;
     attributes = g_ptr_array_new();
+    attributes_names = g_hash_table_new(g_str_hash, g_str_equal);
+
+    // Built-in attributes must be registered following AttributeId order
 
     //! Call Index
     attribute = attribute_new("index", "Idx", "Call Index", 4);
-    attribute_set_getter_func(attribute, attribute_getter_call_index);
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_INTEGER, attribute_getter_call_index);
+    attribute_register(attribute);
 
     //! From SIP header
     attribute = attribute_new("sipfrom", NULL, "SIP From", 25);
-    attribute_set_regex_pattern(attribute, "^(From|f):[^:]+:(?P<value>([^@;>\r]+@)?[^;>\r]+)");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_sipfrom);
+    attribute_register(attribute);
 
     //! From SIP header (URI user part)
     attribute = attribute_new("sipfromuser", NULL, "SIP From User", 20);
-    attribute_set_regex_pattern(attribute, "^(From|f):[^:]+:(?P<value>[^@;>\r]+)");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_sipfromuser);
+    attribute_register(attribute);
 
     //! To SIP header
     attribute = attribute_new("sipto", NULL, "SIP To", 25);
-    attribute_set_regex_pattern(attribute, "^(To|t):[^:]+:(?P<value>([^@;>\r]+@)?[^\r;>]+)");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_sipto);
+    attribute_register(attribute);
 
     //! To SIP header (URI user part )
     attribute = attribute_new("siptouser", NULL, "SIP To User", 20);
-    attribute_set_regex_pattern(attribute, "^(To|t):[^:]+:(?P<value>[^@;>\r]+)");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_siptouser);
+    attribute_register(attribute);
 
     //! Source ip:port address
     attribute = attribute_new("src", NULL, "Source", 22);
-    attribute_set_getter_func(attribute, attribute_getter_msg_source);
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_ADDRESS, attribute_getter_msg_source);
+    attribute_register(attribute);
 
     //! Destination ip:port address
     attribute = attribute_new("dst", NULL, "Destination", 22);
-    attribute_set_getter_func(attribute, attribute_getter_msg_destination);
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_ADDRESS, attribute_getter_msg_destination);
+    attribute_register(attribute);
 
     //! Call-Id SIP header
     attribute = attribute_new("callid", NULL, "Call-ID", 50);
-    attribute_set_regex_pattern(attribute, "^(Call-ID|i):\\s*(?P<value>.+)$");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_callid);
+    attribute_register(attribute);
 
     //! X-Call-Id SIP header
     attribute = attribute_new("xcallid", NULL, "X-Call-ID", 50);
-    attribute_set_regex_pattern(attribute, "^(X-Call-ID|X-CID):\\s*(?P<value>.+)$");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_xcallid);
+    attribute_register(attribute);
 
     //! Packet captured date
     attribute = attribute_new("date", NULL, "Date", 10);
-    attribute_set_getter_func(attribute, attribute_getter_msg_date);
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_TIMESTAMP, attribute_getter_msg_timestamp);
+    attribute_set_format_func(attribute, attribute_format_date);
+    attribute_register(attribute);
 
     //! Packet captured time
     attribute = attribute_new("time", NULL, "Time", 8);
-    attribute_set_getter_func(attribute, attribute_getter_msg_time);
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_TIMESTAMP, attribute_getter_msg_timestamp);
+    attribute_register(attribute);
 
     //! SIP Method
     attribute = attribute_new("method", NULL, "Method", 8);
     attribute_set_getter_func(attribute, attribute_getter_msg_method);
     attribute_set_color_func(attribute, attribute_color_sip_method);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! SIP Transport (SIP over TCP, UDP, WS, ...)
     attribute = attribute_new("transport", "Trans", "Transport", 3);
     attribute_set_getter_func(attribute, attribute_getter_msg_transport);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! Owner call message count
     attribute = attribute_new("msgcnt", "Msgs", "Message Count", 4);
-    attribute_set_getter_func(attribute, attribute_getter_call_msgcnt);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_INTEGER, attribute_getter_call_msgcnt);
     attribute_set_mutable(attribute, TRUE);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! Owner call state
     attribute = attribute_new("state", NULL, "Call-State", 12);
     attribute_set_getter_func(attribute, attribute_getter_call_state);
     attribute_set_color_func(attribute, attribute_color_call_state);
     attribute_set_mutable(attribute, TRUE);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! Conversation duration (from first 200 OK)
     attribute = attribute_new("convdur", "ConvDur", "Conversation Duration", 7);
-    attribute_set_getter_func(attribute, attribute_getter_call_convdur);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_DURATION, attribute_getter_call_convdur);
     attribute_set_mutable(attribute, TRUE);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! Total duration (from first to last message in dialog)
     attribute = attribute_new("totaldur", "TotalDur", "Total Duration", 8);
-    attribute_set_getter_func(attribute, attribute_getter_call_totaldur);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_DURATION, attribute_getter_call_totaldur);
     attribute_set_mutable(attribute, TRUE);
-    g_ptr_array_add(attributes, attribute);
+    attribute_register(attribute);
 
     //! Reason SIP header
     attribute = attribute_new("reason", "Reason", "Reason Text", 25);
-    attribute_set_regex_pattern(attribute, "Reason:[ ]*[^\r]*;text=\"(?<value>[^\r]+)\"");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_getter_func(attribute, attribute_getter_msg_reason);
+    attribute_register(attribute);
 
     //! Warning SIP header
     attribute = attribute_new("warning", "Warning", "Warning Code", 4);
-    attribute_set_regex_pattern(attribute, "^Warning:\\s*(?P<value>\\d+)");
-    g_ptr_array_add(attributes, attribute);
+    attribute_set_typed_getter_func(attribute, ATTR_TYPE_INTEGER, attribute_getter_msg_warning);
+    attribute_register(attribute);
+
+    g_assert(attribute_count() == ATTR_ID_BUILTIN_COUNT);
 }
 
 void
@@ -30,18 +30,49 @@
 #define __SNGREP_ATTRIBUTE_H
 
 #include <glib.h>
+#include "address.h"
 
 //! Max attribute length
 #define ATTR_MAXLEN 255
 
+//! Attribute value types
+enum AttributeType
+{
+    //! Text values
+    ATTR_TYPE_STRING = 0,
+    //! Integer values
+    ATTR_TYPE_INTEGER,
+    //! Time intervals in microseconds
+    ATTR_TYPE_DURATION,
+    //! Unix timestamps in microseconds
+    ATTR_TYPE_TIMESTAMP,
+    //! Network addresses
+    ATTR_TYPE_ADDRESS,
+};
+
 //! Attribute types
 typedef struct _Attribute Attribute;
 typedef struct _Message Message;
 
+/**
+ * @brief Typed attribute value
+ */
+typedef struct
+{
+    //! Integer, duration and timestamp values
+    gint64 number;
+    //! Address values (not owned)
+    Address address;
+} AttributeTypedValue;
+
 typedef gint (*AttributeColorFunc)(const gchar *);
 
 typedef gchar *(*AttributeGetterFunc)(Attribute *, Message *);
 
+typedef gboolean (*AttributeTypedGetterFunc)(Attribute *, Message *, AttributeTypedValue *);
+
+typedef gchar *(*AttributeFormatFunc)(Attribute *, const AttributeTypedValue *);
+
 /**
  * @brief Available SIP Attributes
  *
@@ -49,7 +80,7 @@ typedef gchar *(*AttributeGetterFunc)(Attribute *, Message *);
  * a call or message can have.
  */
 
-#define ATTR_CALLINDEX      "callindex"         //! Call index in the Call List
+#define ATTR_CALLINDEX      "index"             //! Call index in the Call List
 #define ATTR_SIPFROM        "sipfrom"           //! SIP Message From: header
 #define ATTR_SIPFROMUSER    "sipfromuser"       //! SIP Message User of From: header
 #define ATTR_SIPTO          "sipto"             //! SIP Message To: header
@@ -63,12 +94,43 @@ typedef gchar *(*AttributeGetterFunc)(Attribute *, Message *);
 #define ATTR_METHOD         "method"            //! SIP Message Method or Response code
 #define ATTR_TRANSPORT      "transport"         //! SIP Message transport
 #define ATTR_MSGCNT         "msgcnt"            //! SIP Call message counter
-#define ATTR_CALLSTATE      "callstate"         //! SIP Call state
+#define ATTR_CALLSTATE      "state"             //! SIP Call state
 #define ATTR_CONVDUR        "convdur"           //! Conversation duration
 #define ATTR_TOTALDUR       "totaldur"          //! Total call duration
-#define ATTR_REASON_TXT     "reason_txt"        //! Text from SIP Reason header
+#define ATTR_REASON_TXT     "reason"            //! Text from SIP Reason header
 #define ATTR_WARNING        "warning"           //! Warning Header
 
+/**
+ * @brief Built-in attributes identifiers
+ *
+ * Built-in attributes are registered in this order, so their identifiers
+ * are known at compile time. Attributes defined in settings get the
+ * following identifiers when they are registered.
+ */
+typedef enum
+{
+    ATTR_ID_CALLINDEX = 0,
+    ATTR_ID_SIPFROM,
+    ATTR_ID_SIPFROMUSER,
+    ATTR_ID_SIPTO,
+    ATTR_ID_SIPTOUSER,
+    ATTR_ID_SRC,
+    ATTR_ID_DST,
+    ATTR_ID_CALLID,
+    ATTR_ID_XCALLID,
+    ATTR_ID_DATE,
+    ATTR_ID_TIME,
+    ATTR_ID_METHOD,
+    ATTR_ID_TRANSPORT,
+    ATTR_ID_MSGCNT,
+    ATTR_ID_CALLSTATE,
+    ATTR_ID_CONVDUR,
+    ATTR_ID_TOTALDUR,
+    ATTR_ID_REASON_TXT,
+    ATTR_ID_WARNING,
+    ATTR_ID_BUILTIN_COUNT,
+} AttributeId;
+
 
 /**
  * @brief Attribute header data
@@ -81,6 +143,8 @@ typedef gchar *(*AttributeGetterFunc)(Attribute *, Message *);
  */
 struct _Attribute
 {
+    //! Registration identifier (index in attributes list)
+    guint id;
     //! Name (Unique identifier)
     gchar *name;
     //! Column title (Displayed in Call List window)
@@ -91,6 +155,8 @@ struct _Attribute
     gboolean mutable;
     //! Determine attribute prefered length
     gint length;
+    //! Attribute value type
+    enum AttributeType type;
 
     //! Regular expression pattern
     const gchar *regexp_pattern;
@@ -99,21 +165,61 @@ struct _Attribute
 
     //! This function calculates attribute value
     AttributeGetterFunc getterFunc;
+    //! This function calculates attribute typed value
+    AttributeTypedGetterFunc typedGetterFunc;
+    //! This function converts typed values to text (NULL for type default)
+    AttributeFormatFunc formatFunc;
     //! This function determines the color of this attribute in CallList
     AttributeColorFunc colorFunc;
 };
 
 /**
  * @brief Single Attribute value
+ *
+ * Each message stores its attribute values in an array indexed by
+ * attribute identifier.
  */
 typedef struct
 {
-    //! Pointer to Attribute Header
-    Attribute *attr;
     //! Actual attribute value
     gchar *value;
+    //! Owner call generation when the value was calculated (mutable attributes)
+    guint generation;
+    //! Value has already been calculated
+    gboolean cached;
 } AttributeValue;
 
+/**
+ * @brief Set the function to calculate attribute typed values
+ *
+ * Text values of typed attributes are only generated when requested
+ * using the attribute format function.
+ *
+ * @param attr Attribute pointer to update
+ * @param type Type of the values returned by the getter function
+ * @param func Typed getter function
+ */
+void
+attribute_set_typed_getter_func(Attribute *attr, enum AttributeType type, AttributeTypedGetterFunc func);
+
+/**
+ * @brief Set the function to convert typed values to text
+ *
+ * @param attr Attribute pointer to update
+ * @param func Format function
+ */
+void
+attribute_set_format_func(Attribute *attr, AttributeFormatFunc func);
+
+/**
+ * @brief Get Attribute value type
+ *
+ * @param attr Attribute pointer
+ * @return attribute value type
+ */
+enum AttributeType
+attribute_get_type(Attribute *attr);
+
 /**
  * @brief Get Attribute description
  *
@@ -201,6 +307,23 @@ attribute_set_length(Attribute *attr, gint length);
 Attribute *
 attribute_find_by_name(const gchar *name);
 
+/**
+ * @brief Get Attribute from its identifier
+ *
+ * @param id Attribute identifier (AttributeId for built-in attributes)
+ * @return Attribute header pointer or NULL if not found
+ */
+Attribute *
+attribute_find_by_id(guint id);
+
+/**
+ * @brief Get the number of registered attributes
+ *
+ * @return registered attributes count (greater than any attribute id)
+ */
+guint
+attribute_count();
+
 /**
  * @brief Return Attribute value for a given message
  * @param name Name of the attribute
@@ -210,6 +333,17 @@ attribute_find_by_name(const gchar *name);
 gchar *
 attribute_get_value(Attribute *attr, Message *msg);
 
+/**
+ * @brief Return Attribute typed value for a given message
+ *
+ * @param attr Attribute with a typed getter function
+ * @param msg Msg to get attribute from
+ * @param value Pointer to store the typed value
+ * @return TRUE if the message has a value for this attribute
+ */
+gboolean
+attribute_get_typed_value(Attribute *attr, Message *msg, AttributeTypedValue *value);
+
 /**
  * @brief Determine the color of the attribute in Call List
  *
@@ -237,20 +371,21 @@ attribute_color_sip_method(const gchar *value);
 gint
 attribute_color_call_state(const gchar *value);
 
-/**
- * @brief Allocate memory to store a cached attribute value
- */
-AttributeValue *
-attribute_value_new(Attribute *attr, gchar *value);
+GPtrArray *
+attribute_get_internal_array();
 
 /**
- * @brief Free allocated memory for an attribute value
+ * @brief Calculate all regular expression attributes of a message
+ *
+ * All regular expression attributes are combined in a single expression,
+ * so message payload is only scanned once. Found values are stored in the
+ * message attribute slots, other attributes are calculated using their
+ * own expression when requested.
+ *
+ * @param msg Message to scan
  */
 void
-attribute_value_free(AttributeValue *attr_value);
-
-GPtrArray *
-attribute_get_internal_array();
+attribute_regex_scan(Message *msg);
 
 void
 attribute_from_setting(const gchar *setting, const gchar *value);
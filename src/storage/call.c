@@ -30,33 +30,43 @@
  */
 #include "config.h"
 #include <glib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
 #include "glib-extra/glib.h"
 #include "call.h"
+#include "intern.h"
 #include "packet/packet_sip.h"
 #include "setting.h"
 #include "message.h"
+#include "storage.h"
+#include "filter.h"
 
 Call *
 call_create(const gchar *callid, const gchar *xcallid)
 {
-    // Initialize a new call structure
-    Call *call = g_malloc0(sizeof(Call));
+    // Initialize a new call structure in its own memory arena
+    Arena *arena = arena_new();
+    Call *call = arena_alloc0(arena, sizeof(Call));
+    call->arena = arena;
 
     // Create a vector to store call messages
     call->msgs = g_ptr_array_new_with_free_func((GDestroyNotify) msg_free);
+    call->msgs_index = g_hash_table_new(msg_hash, msg_equal);
 
     // Create an empty vector to store stream data
     call->streams = g_ptr_array_new_with_free_func((GDestroyNotify) stream_free);
+    call->streams_index = g_hash_table_new(stream_hash, stream_equal);
 
     // Create an empty vector to store x-calls
     call->xcalls = g_ptr_array_new();
 
     // Initialize call filter status
-    call->filtered = -1;
+    call->filtered = FILTER_CALL_UNCHECKED;
 
     // Set message callid
-    call->callid = callid;
-    call->xcallid = xcallid;
+    call->callid = intern_ref(callid);
+    call->xcallid = intern_ref(xcallid);
 
     return call;
 }
@@ -66,15 +76,24 @@ call_destroy(gpointer item)
 {
     Call *call = item;
     // Remove all call messages
+    g_hash_table_destroy(call->msgs_index);
     g_ptr_array_free(call->msgs, TRUE);
     // Remove all call streams
+    g_hash_table_destroy(call->streams_index);
     g_ptr_array_free(call->streams, TRUE);
     // Remove all xcalls
     g_ptr_array_free(call->xcalls, TRUE);
 
     // Deallocate call memory
     g_free(call->reasontxt);
-    g_free(call);
+    g_free(call->sort_text);
+    intern_unref(call->callid);
+    intern_unref(call->xcallid);
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        intern_unref(call->index_keys[i]);
+    }
+    // Release call structure and all its arena allocated data
+    arena_free(call->arena);
 }
 
 void
@@ -82,10 +101,16 @@ call_add_message(Call *call, Message *msg)
 {
     // Set the message owner
     msg->call = call;
+    // Check if a previous message has the same addresses and payload
+    Message *prev = g_hash_table_lookup(call->msgs_index, msg);
+    // Payload hashes can collide, compare payloads once on each match
+    msg->retrans = (prev != NULL && msg_payload_equal(prev, msg)) ? prev : NULL;
+    // Replace the key too, so retransmissions point to the latest message
+    g_hash_table_replace(call->msgs_index, msg, msg);
     // Put this msg at the end of the msg list
     g_ptr_array_add(call->msgs, msg);
     // Flag this call as changed
-    call->changed = TRUE;
+    call->generation++;
 }
 
 void
@@ -93,8 +118,12 @@ call_add_stream(Call *call, Stream *stream)
 {
     // Store stream
     g_ptr_array_add(call->streams, stream);
+    // Index stream for fast lookups (first added stream wins)
+    if (!g_hash_table_contains(call->streams_index, stream)) {
+        g_hash_table_insert(call->streams_index, stream, stream);
+    }
     // Flag this call as changed
-    call->changed = TRUE;
+    call->generation++;
 }
 
 guint
@@ -128,6 +157,9 @@ call_update_state(Call *call, Message *msg)
     guint msg_reqresp = msg_get_method(msg);
     guint64 msg_cseq = msg_get_cseq(msg);
 
+    // Call state and conversation messages may change
+    call->generation++;
+
     // If this message is actually a call, get its current state
     if (call->state) {
         if (call->state == CALL_STATE_CALLSETUP) {
@@ -190,47 +222,88 @@ call_state_to_str(enum CallState state)
     return "";
 }
 
-gint
-call_attr_compare(const Call *one, const Call *two, Attribute *attr)
+/**
+ * @brief Get a text sort key for an address
+ *
+ * Address bytes and port are encoded as fixed width hexadecimal text,
+ * so comparing keys as strings sorts addresses numerically.
+ *
+ * @return allocated sort key or NULL if address is not valid
+ */
+static gchar *
+call_sort_key_address(Address address)
 {
-    const gchar *onevalue = NULL, *twovalue = NULL;
-    int oneintvalue = 0, twointvalue = 0;
-    int comparetype; /* TODO 0 = string compare, 1 = int compare */
-    Message *msg_one = g_ptr_array_first(one->msgs);
-    Message *msg_two = g_ptr_array_first(two->msgs);
-
-    if (g_strcmp0(attr->name, ATTR_CALLINDEX) == 0) {
-        oneintvalue = one->index;
-        twointvalue = two->index;
-        comparetype = 1;
-    } else if (g_strcmp0(attr->name, ATTR_MSGCNT) == 0) {
-        oneintvalue = call_msg_count(one);
-        twointvalue = call_msg_count(two);
-        comparetype = 1;
-    } else {
-        // Get attribute values
-        onevalue = msg_get_attribute(msg_one, attr);
-        twovalue = msg_get_attribute(msg_two, attr);
-        comparetype = 0;
+    guint8 addr[16] = { 0 };
+    gint family = (strchr(address_get_ip(address), ':') != NULL) ? AF_INET6 : AF_INET;
+    gsize len = (family == AF_INET6) ? 16 : 4;
+
+    if (inet_pton(family, address_get_ip(address), addr) != 1)
+        return NULL;
+
+    GString *key = g_string_sized_new(len * 2 + 6);
+    g_string_append_c(key, (family == AF_INET6) ? '6' : '4');
+    for (gsize i = 0; i < len; i++) {
+        g_string_append_printf(key, "%02x", addr[i]);
     }
+    g_string_append_printf(key, "%04x", address_get_port(address));
+    return g_string_free(key, FALSE);
+}
+
+gboolean
+call_sort_key_update(Call *call, Attribute *attr)
+{
+    gint64 number = G_MININT64;
+    g_autofree gchar *text = NULL;
+    AttributeTypedValue value = { 0 };
+
+    Message *first = g_ptr_array_first(call->msgs);
+    g_return_val_if_fail(first != NULL, FALSE);
 
-    switch (comparetype) {
-        case 0:
-            if (twovalue == NULL && onevalue == NULL)
-                return 0;
-            if (twovalue == NULL)
-                return 1;
-            if (onevalue == NULL)
-                return -1;
-            return strcmp(onevalue, twovalue);
-        case 1:
-            if (oneintvalue == twointvalue) return 0;
-            if (oneintvalue > twointvalue) return 1;
-            if (oneintvalue < twointvalue) return -1;
-            /* fall-thru */
+    switch (attribute_get_type(attr)) {
+        case ATTR_TYPE_STRING:
+            text = g_strdup(msg_get_attribute(first, attr));
+            break;
+        case ATTR_TYPE_ADDRESS:
+            if (attribute_get_typed_value(attr, first, &value)) {
+                text = call_sort_key_address(value.address);
+            }
+            break;
         default:
-            return 0;
+            if (attribute_get_typed_value(attr, first, &value)) {
+                number = value.number;
+            }
+            break;
     }
+
+    if (number == call->sort_number && g_strcmp0(text, call->sort_text) == 0)
+        return FALSE;
+
+    call->sort_number = number;
+    g_free(call->sort_text);
+    call->sort_text = g_steal_pointer(&text);
+    return TRUE;
+}
+
+gint
+call_sort_key_compare(const Call *one, const Call *two)
+{
+    if (one->sort_number != two->sort_number)
+        return (one->sort_number > two->sort_number) ? 1 : -1;
+
+    if (one->sort_text != two->sort_text) {
+        if (one->sort_text == NULL)
+            return -1;
+        if (two->sort_text == NULL)
+            return 1;
+
+        gint cmp = strcmp(one->sort_text, two->sort_text);
+        if (cmp != 0)
+            return (cmp > 0) ? 1 : -1;
+    }
+
+    if (one->index == two->index)
+        return 0;
+    return (one->index > two->index) ? 1 : -1;
 }
 
 void
@@ -240,7 +313,7 @@ call_add_xcall(Call *call, Call *xcall)
         return;
 
     // Mark this call as changed
-    call->changed = TRUE;
+    call->generation++;
 
     // Add the xcall to the list
     g_ptr_array_add(call->xcalls, xcall);
@@ -249,18 +322,7 @@ call_add_xcall(Call *call, Call *xcall)
 Stream *
 call_find_stream(Call *call, const Address src, const Address dst, guint32 ssrc)
 {
-    Stream *stream = NULL;
-
-    // Create an iterator for call streams
-    for (guint i = 0; i < g_ptr_array_len(call->streams); i++) {
-        stream = g_ptr_array_index(call->streams, i);
-        if (addressport_equals(src, stream->src) &&
-            addressport_equals(dst, stream->dst)
-            && ssrc == stream->ssrc) {
-            return stream;
-        }
-    }
-
-    // Nothing found
-    return NULL;
+    // Search the stream using a key with the same identifying data
+    Stream key = { .src = src, .dst = dst, .ssrc = ssrc };
+    return g_hash_table_lookup(call->streams_index, &key);
 }
@@ -32,6 +32,7 @@
 #include <glib.h>
 #include "stream.h"
 #include "message.h"
+#include "arena.h"
 #include "storage/attribute.h"
 
 //! Shorter declaration of sip_call structure
@@ -49,6 +50,16 @@ enum CallState
     CALL_STATE_COMPLETED
 };
 
+//! Call attributes with a secondary index in storage
+enum CallIndex
+{
+    CALL_INDEX_SIPFROM = 0,
+    CALL_INDEX_SIPTO,
+    CALL_INDEX_SRC,
+    CALL_INDEX_DST,
+    CALL_INDEX_COUNT
+};
+
 /**
  * @brief Contains all information of a call and its messages
  *
@@ -58,20 +69,48 @@ enum CallState
  */
 struct _Call
 {
+    //! Memory arena for call messages, streams and their data
+    Arena *arena;
     //! Call index in the call list
     guint index;
-    //! Call identifier
+    //! Call identifier (interned)
     const gchar *callid;
-    //! Related Call identifier
+    //! Related Call identifier (interned)
     const gchar *xcallid;
-    //! Flag this call as filtered so won't be displayed
+    //! Display filters result (enum FilterCallResult)
     gchar filtered;
     //! Call State. For dialogs starting with an INVITE method
     enum CallState state;
-    //! Changed flag. For interface optimal updates
-    gboolean changed;
+    //! Change counter. Checked by interface and invalidates mutable attribute cached values
+    guint generation;
     //! Locked flag. Calls locked are never deleted
     gboolean locked;
+    //! Removed flag. Call is no longer indexed and will be freed
+    gboolean removed;
+    //! Storage insertion order list node
+    GList order_link;
+    //! Cold flag. Call contents are compressed and RTP packets discarded
+    gboolean cold;
+    //! Last time this call had activity (monotonic microseconds)
+    gint64 updated;
+    //! Storage activity order list node (only for non cold calls)
+    GList idle_link;
+    //! Sort attribute numeric value
+    gint64 sort_number;
+    //! Sort attribute text value
+    gchar *sort_text;
+    //! Storage sorted calls sequence node
+    GSequenceIter *sort_iter;
+    //! Storage displayed calls sequence node (NULL if filtered)
+    GSequenceIter *display_iter;
+    //! First message unix timestamp in microseconds
+    guint64 start_time;
+    //! Storage start time ordered calls sequence node
+    GSequenceIter *time_iter;
+    //! First message indexed attribute values (interned, indexed by CallIndex)
+    const gchar *index_keys[CALL_INDEX_COUNT];
+    //! Storage secondary indexes list nodes (indexed by CallIndex)
+    GList index_links[CALL_INDEX_COUNT];
     //! Last reason text value for this call
     gchar *reasontxt;
     //! Last warning text value for this call
@@ -82,10 +121,14 @@ struct _Call
     guint64 invitecseq;
     //! Array of messages of this call (sip_msg_t*)
     GPtrArray *msgs;
+    //! Last message indexed by source, destination and payload
+    GHashTable *msgs_index;
     //! Message when conversation started and ended
     Message *cstart_msg, *cend_msg;
     //! RTP streams for this call (rtp_stream_t *)
     GPtrArray *streams;
+    //! RTP streams indexed by source, destination and SSRC
+    GHashTable *streams_index;
     //! RTP packets for this call (capture_packet_t *)
     GSequence *rtp_packets;
 };
@@ -186,14 +229,29 @@ const gchar *
 call_state_to_str(enum CallState state);
 
 /**
- * @brief Compare two calls based on a given attribute
+ * @brief Update call sort key with current attribute value
+ *
+ * Typed attributes are sorted by their numeric value, while text
+ * attributes are sorted by their text value.
+ *
+ * @param call Call structure to be updated
+ * @param attr Sort attribute
+ * @return TRUE if the sort key has changed, FALSE otherwise
+ */
+gboolean
+call_sort_key_update(Call *call, Attribute *attr);
+
+/**
+ * @brief Compare two calls based on their sort keys
+ *
+ * Calls with the same sort key are compared by their index.
  *
- * @return 0 if call attributes are equal
+ * @return 0 if call sort keys are equal
  * @return 1 if first call is greater
  * @return -1 if first call is lesser
  */
 gint
-call_attr_compare(const Call *one, const Call *two, Attribute *attr);
+call_sort_key_compare(const Call *one, const Call *two);
 
 /**
  * @brief Relate this two calls
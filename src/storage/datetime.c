@@ -27,30 +27,124 @@
  *
  */
 #include "config.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <glib.h>
-#include <glib/gprintf.h>
 #include "glib-extra/glib.h"
 #include "datetime.h"
 
+/**
+ * @brief Broken-down local time of the last formatted second
+ *
+ * Consecutive timestamps usually belong to the same second, so date and
+ * time of day are only calculated when the second changes.
+ */
+typedef struct
+{
+    //! Cached second (unix timestamp)
+    gint64 sec;
+    //! Date in yyyy/mm/dd format
+    gchar date[11];
+    //! Time of day in HH:MM:SS format
+    gchar time[9];
+} DateTimeCache;
+
+//! Last formatted second
+static DateTimeCache cache = { .sec = -1 };
+//! Lock for formatted second cache
+static GMutex cache_lock;
+
+/**
+ * @brief Write a zero padded decimal number
+ *
+ * @param out Output buffer with at least width bytes
+ * @param value Number to write
+ * @param width Number of digits to write
+ * @return pointer to the byte after last written digit
+ */
+static gchar *
+date_time_put_digits(gchar *out, guint64 value, guint width)
+{
+    for (guint i = width; i > 0; i--) {
+        out[i - 1] = (gchar) ('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+/**
+ * @brief Write a decimal number without padding
+ *
+ * @return pointer to the byte after last written digit
+ */
+static gchar *
+date_time_put_number(gchar *out, guint64 value)
+{
+    guint width = 1;
+    for (guint64 tmp = value; tmp >= 10; tmp /= 10) {
+        width++;
+    }
+    return date_time_put_digits(out, value, width);
+}
+
+/**
+ * @brief Copy the cached date and time of day of a timestamp
+ */
+static void
+date_time_cache_lookup(guint64 ts, gchar *date, gchar *time)
+{
+    gint64 sec = (gint64) (ts / G_USEC_PER_SEC);
+
+    g_mutex_lock(&cache_lock);
+    if (cache.sec != sec) {
+        struct tm tm;
+        time_t t = (time_t) sec;
+        localtime_r(&t, &tm);
+
+        gchar *out = cache.date;
+        out = date_time_put_digits(out, (guint64) tm.tm_year + 1900, 4);
+        *out++ = '/';
+        out = date_time_put_digits(out, (guint64) tm.tm_mon + 1, 2);
+        *out++ = '/';
+        out = date_time_put_digits(out, (guint64) tm.tm_mday, 2);
+        *out = '\0';
+
+        out = cache.time;
+        out = date_time_put_digits(out, (guint64) tm.tm_hour, 2);
+        *out++ = ':';
+        out = date_time_put_digits(out, (guint64) tm.tm_min, 2);
+        *out++ = ':';
+        out = date_time_put_digits(out, (guint64) tm.tm_sec, 2);
+        *out = '\0';
+
+        cache.sec = sec;
+    }
+
+    if (date != NULL)
+        memcpy(date, cache.date, sizeof(cache.date));
+    if (time != NULL)
+        memcpy(time, cache.time, sizeof(cache.time));
+    g_mutex_unlock(&cache_lock);
+}
+
 const gchar *
 date_time_date_to_str(guint64 ts, gchar *out)
 {
-    g_autoptr(GDateTime) time = g_date_time_new_from_unix_usec(ts);
-    g_sprintf(out, "%s", g_date_time_format(time, "%Y/%m/%d"));
+    date_time_cache_lookup(ts, out, NULL);
     return out;
 }
 
-
 const gchar *
 date_time_time_to_str(guint64 ts, gchar *out)
 {
-    g_autoptr(GDateTime) time = g_date_time_new_from_unix_usec(ts);
+    date_time_cache_lookup(ts, NULL, out);
 
-    g_sprintf(out, "%s.%06d",
-              g_date_time_format(time, "%H:%M:%S"),
-              g_date_time_get_microsecond(time)
-    );
+    gchar *usec = out + sizeof(cache.time) - 1;
+    *usec++ = '.';
+    usec = date_time_put_digits(usec, ts % G_USEC_PER_SEC, 6);
+    *usec = '\0';
 
     return out;
 }
@@ -63,14 +157,14 @@ date_time_to_duration(guint64 start, guint64 end, gchar *out)
     if (start == 0 || end == 0)
         return NULL;
 
-    g_autoptr(GDateTime) start_time = g_date_time_new_from_unix_usec(start);
-    g_autoptr(GDateTime) end_time = g_date_time_new_from_unix_usec(end);
-
     // Difference in seconds
-    glong seconds = g_date_time_difference(end_time, start_time) / G_USEC_PER_SEC;
+    guint64 seconds = (end > start) ? (end - start) / G_USEC_PER_SEC : 0;
 
     // Set Human readable format
-    g_sprintf(out, "%lu:%02lu", seconds / 60, seconds % 60);
+    gchar *pos = date_time_put_number(out, seconds / 60);
+    *pos++ = ':';
+    pos = date_time_put_digits(pos, seconds % 60, 2);
+    *pos = '\0';
     return out;
 }
 
@@ -82,17 +176,14 @@ date_time_to_delta(guint64 start, guint64 end, gchar *out)
     if (start == 0 || end == 0)
         return NULL;
 
-    g_autoptr(GDateTime) start_time = g_date_time_new_from_unix_usec(start);
-    g_autoptr(GDateTime) end_time = g_date_time_new_from_unix_usec(end);
-
-    glong diff = g_date_time_difference(end_time, start_time);
-
-    glong nsec = diff / G_USEC_PER_SEC;
-    glong nusec = labs(diff - (nsec * G_USEC_PER_SEC));
-
-    gint sign = (diff >= 0) ? '+' : '-';
+    guint64 diff = (end >= start) ? end - start : start - end;
 
-    g_sprintf(out, "%c%ld.%06lu", sign, labs(nsec), nusec);
+    gchar *pos = out;
+    *pos++ = (end >= start) ? '+' : '-';
+    pos = date_time_put_number(pos, diff / G_USEC_PER_SEC);
+    *pos++ = '.';
+    pos = date_time_put_digits(pos, diff % G_USEC_PER_SEC, 6);
+    *pos = '\0';
     return out;
 }
 
@@ -101,3 +192,40 @@ date_time_to_unix_ms(guint64 ts)
 {
     return ((gdouble) ts / G_MSEC_PER_SEC);
 }
+
+guint64
+date_time_from_str(const gchar *text, guint64 ref)
+{
+    g_return_val_if_fail(text != NULL, 0);
+
+    // Start from the reference date
+    struct tm tm;
+    time_t t = (time_t) (ref / G_USEC_PER_SEC);
+    localtime_r(&t, &tm);
+
+    gint year, month, day, hour, min, sec = 0;
+    if (sscanf(text, "%d/%d/%d %d:%d:%d", &year, &month, &day, &hour, &min, &sec) >= 5) {
+        if (month < 1 || month > 12 || day < 1 || day > 31)
+            return 0;
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+    } else {
+        sec = 0;
+        if (sscanf(text, "%d:%d:%d", &hour, &min, &sec) < 2)
+            return 0;
+    }
+
+    if (hour < 0 || hour > 23 || min < 0 || min > 59 || sec < 0 || sec > 59)
+        return 0;
+
+    tm.tm_hour = hour;
+    tm.tm_min = min;
+    tm.tm_sec = sec;
+    tm.tm_isdst = -1;
+
+    if ((t = mktime(&tm)) == (time_t) -1)
+        return 0;
+
+    return (guint64) t * G_USEC_PER_SEC;
+}
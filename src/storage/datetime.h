@@ -35,12 +35,16 @@
 
 /**
  * @brief Convert timeval to yyyy/mm/dd format
+ *
+ * @param out Output buffer of at least 11 bytes
  */
 const gchar *
 date_time_date_to_str(guint64 ts, gchar *out);
 
 /**
  * @brief Convert timeval to HH:MM:SS.mmmmmm format
+ *
+ * @param out Output buffer of at least 16 bytes
  */
 const gchar *
 date_time_time_to_str(guint64 ts, gchar *out);
@@ -65,4 +69,14 @@ date_time_to_delta(guint64 start, guint64 end, gchar *out);
 gdouble
 date_time_to_unix_ms(guint64 ts);
 
+/**
+ * @brief Convert a local time in [yyyy/mm/dd] HH:MM[:SS] format to timeval
+ *
+ * @param text Text to be parsed
+ * @param ref Timestamp whose date is used when text has no date
+ * @return unix timestamp microseconds or 0 if text is not valid
+ */
+guint64
+date_time_from_str(const gchar *text, guint64 ref);
+
 #endif /* __SNGREP_TIMEVAL_H */
@@ -31,11 +31,12 @@
 #include <stdlib.h>
 #include "glib-extra/glib.h"
 #include "storage/storage.h"
-#include "tui/windows/call_list_win.h"
 #include "filter.h"
 
 //! Storage of filter information
 Filter filters[FILTER_COUNT] = {{ 0 }};
+//! Attributes of the call list line (Attribute *)
+static GPtrArray *line_attributes = NULL;
 
 gboolean
 filter_set(enum FilterType type, const gchar *expr)
@@ -70,90 +71,192 @@ filter_get(enum FilterType type)
     return filters[type].expr;
 }
 
-gboolean
-filter_check_call(Call *call, G_GNUC_UNUSED gconstpointer user_data)
+void
+filter_set_line_attributes(GPtrArray *attributes)
 {
-    // Dont filter calls without messages
-    if (call_msg_count(call) == 0)
-        return FALSE;
+    g_clear_pointer(&line_attributes, g_ptr_array_unref);
+    if (attributes != NULL) {
+        line_attributes = g_ptr_array_deep_copy(attributes);
+    }
+}
 
-    // Filter for this call has already be processed
-    if (call->filtered != -1)
-        return (call->filtered == 0);
+/**
+ * @brief Get the call list line text of a call
+ *
+ * Line is built concatenating first message values of the line attributes.
+ *
+ * @return allocated line text
+ */
+static gchar *
+filter_line_text(Message *msg)
+{
+    GString *out = g_string_new(NULL);
+    if (line_attributes == NULL)
+        return g_string_free(out, FALSE);
 
-    // By default, call matches all filters
-    call->filtered = 0;
+    for (guint i = 0; i < g_ptr_array_len(line_attributes); i++) {
+        const gchar *value = msg_get_attribute(msg, g_ptr_array_index(line_attributes, i));
+        if (value != NULL) {
+            g_string_append(out, value);
+        }
+    }
 
-    // Filter attributes based on first call message
-    Message *msg = g_ptr_array_first(call->msgs);
-    g_return_val_if_fail(msg != NULL, FALSE);
+    return g_string_free(out, FALSE);
+}
 
-    // Check all filter types
+/**
+ * @brief Check filters of values taken from the call first message
+ *
+ * These values do not change when new messages are added to the call.
+ *
+ * @return TRUE if all these filters match
+ */
+static gboolean
+filter_check_first_message(Call *call, Message *msg)
+{
     for (guint filter_type = 0; filter_type < FILTER_COUNT; filter_type++) {
 
         // If filter is not enabled, go to the next
         if (!filters[filter_type].expr)
             continue;
 
-        // Initialize
-        const gchar *data = NULL;
-
         // Get filtered field
+        const gchar *data = NULL;
         switch (filter_type) {
             case FILTER_SIPFROM:
-                data = msg_get_attribute(msg, attribute_find_by_name(ATTR_SIPFROM));
+                data = call->index_keys[CALL_INDEX_SIPFROM];
                 break;
             case FILTER_SIPTO:
-                data = msg_get_attribute(msg, attribute_find_by_name(ATTR_SIPTO));
+                data = call->index_keys[CALL_INDEX_SIPTO];
                 break;
             case FILTER_SOURCE:
-                data = msg_get_attribute(msg, attribute_find_by_name(ATTR_SRC));
+                data = call->index_keys[CALL_INDEX_SRC];
                 break;
             case FILTER_DESTINATION:
-                data = msg_get_attribute(msg, attribute_find_by_name(ATTR_DST));
+                data = call->index_keys[CALL_INDEX_DST];
                 break;
             case FILTER_METHOD:
-                data = msg_get_attribute(msg, attribute_find_by_name(ATTR_METHOD));
-                break;
-            case FILTER_PAYLOAD:
-                break;
-            case FILTER_CALL_LIST:
-                // FIXME Maybe call should know hot to calculate this line
-                data = call_list_win_line_text(tui_find_by_type(WINDOW_CALL_LIST), call);
+                data = msg_get_attribute(msg, attribute_find_by_id(ATTR_ID_METHOD));
                 break;
             default:
-                // Unknown filter id
-                return FALSE;
+                // Payload and call list filters are checked separately
+                continue;
         }
 
-        // For payload filtering, check all messages payload
-        if (filter_type == FILTER_PAYLOAD) {
-            // Assume this call doesn't match the filter
-            call->filtered = 1;
-            // Create an iterator for the call messages
-            for (guint j = 0; j < g_ptr_array_len(call->msgs); j++) {
-                msg = g_ptr_array_index(call->msgs, j);
-                // Check if this payload matches the filter
-                g_autofree gchar *payload = msg_get_payload(msg);
-                if (filter_check_expr(filters[filter_type], payload) == 0) {
-                    call->filtered = 0;
-                    break;
-                }
-            }
-            if (call->filtered == 1)
-                break;
-        } else {
-            // Check the filter against given data
-            if (filter_check_expr(filters[filter_type], data) != 0) {
-                // The data didn't matched the filter
-                call->filtered = 1;
-                break;
-            }
+        // Check the filter against given data
+        if (data == NULL || filter_check_expr(filters[filter_type], data) != 0)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Check payload filter against a single message
+ *
+ * @return TRUE if payload filter is not set or message payload matches it
+ */
+static gboolean
+filter_check_message_payload(Message *msg)
+{
+    if (!filters[FILTER_PAYLOAD].expr)
+        return TRUE;
+
+    g_autoptr(GBytes) payload = msg_get_payload(msg);
+    if (payload == NULL)
+        return FALSE;
+
+    return filter_check_expr_len(filters[FILTER_PAYLOAD],
+                                 g_bytes_get_data(payload, NULL),
+                                 g_bytes_get_size(payload)) == 0;
+}
+
+/**
+ * @brief Check call list filter of a call matching all other filters
+ *
+ * Line values can change with each new message of the call, so this
+ * filter is always checked again.
+ *
+ * @return TRUE if call matches all filters
+ */
+static gboolean
+filter_check_call_line(Call *call)
+{
+    call->filtered = FILTER_CALL_MATCH;
+
+    if (filters[FILTER_CALL_LIST].expr) {
+        g_autofree gchar *line = filter_line_text(g_ptr_array_first(call->msgs));
+        if (filter_check_expr(filters[FILTER_CALL_LIST], line) != 0) {
+            call->filtered = FILTER_CALL_NO_LINE;
         }
     }
 
-    // Return the final filter status
-    return (call->filtered == 0);
+    return call->filtered == FILTER_CALL_MATCH;
+}
+
+gboolean
+filter_check_call(Call *call, G_GNUC_UNUSED gconstpointer user_data)
+{
+    // Dont filter calls without messages
+    if (call_msg_count(call) == 0)
+        return FALSE;
+
+    // Filter for this call has already be processed
+    if (call->filtered != FILTER_CALL_UNCHECKED)
+        return (call->filtered == FILTER_CALL_MATCH);
+
+    // Filter attributes based on first call message
+    Message *msg = g_ptr_array_first(call->msgs);
+    g_return_val_if_fail(msg != NULL, FALSE);
+
+    if (!filter_check_first_message(call, msg)) {
+        call->filtered = FILTER_CALL_NO_MATCH;
+        return FALSE;
+    }
+
+    // For payload filtering, check all messages payload
+    gboolean payload = FALSE;
+    for (guint i = 0; i < g_ptr_array_len(call->msgs) && !payload; i++) {
+        payload = filter_check_message_payload(g_ptr_array_index(call->msgs, i));
+    }
+
+    if (!payload) {
+        call->filtered = FILTER_CALL_NO_PAYLOAD;
+        return FALSE;
+    }
+
+    return filter_check_call_line(call);
+}
+
+gboolean
+filter_check_call_message(Call *call, Message *msg)
+{
+    switch (call->filtered) {
+        case FILTER_CALL_NO_MATCH:
+            // First message values do not change with new messages
+            return FALSE;
+        case FILTER_CALL_NO_PAYLOAD:
+            // Only the new message payload needs to be checked
+            if (!filter_check_message_payload(msg))
+                return FALSE;
+            return filter_check_call_line(call);
+        case FILTER_CALL_MATCH:
+        case FILTER_CALL_NO_LINE:
+            // Payload already matched, but line values may have changed
+            return filter_check_call_line(call);
+        default:
+            return filter_check_call(call, NULL);
+    }
+}
+
+gboolean
+filter_check_value(enum FilterType type, const gchar *value)
+{
+    // Filter not enabled
+    if (!filters[type].expr)
+        return TRUE;
+
+    return value != NULL && filter_check_expr(filters[type], value) == 0;
 }
 
 int
@@ -162,16 +265,22 @@ filter_check_expr(Filter filter, const gchar *data)
     return (g_regex_match(filter.regex, data, 0, NULL)) ? 0 : 1;
 }
 
-static void
-filter_mark_call_unfiltered(Call *call, G_GNUC_UNUSED gpointer user_data)
+gint
+filter_check_expr_len(Filter filter, const gchar *data, gsize len)
+{
+    return (g_regex_match_full(filter.regex, data, (gssize) len, 0, 0, NULL, NULL)) ? 0 : 1;
+}
+
+void
+filter_reset_call(Call *call)
 {
-    call->filtered = -1;
+    call->filtered = FILTER_CALL_UNCHECKED;
 }
 
 void
 filter_reset_calls()
 {
-    g_ptr_array_foreach(storage_calls(), (GFunc) filter_mark_call_unfiltered, NULL);
+    storage_calls_refilter();
 }
 
 void
@@ -61,6 +61,21 @@ enum FilterType
     FILTER_COUNT,          // Number of available filter types
 };
 
+/**
+ * @brief Result of checking filters in a call
+ *
+ * Each failing result tells which filters must be checked again when
+ * a new message is added to the call.
+ */
+enum FilterCallResult
+{
+    FILTER_CALL_UNCHECKED = -1,  // Filters must be checked
+    FILTER_CALL_MATCH = 0,       // Call matches all filters
+    FILTER_CALL_NO_MATCH,        // First message values do not match
+    FILTER_CALL_NO_PAYLOAD,      // No message payload matches yet
+    FILTER_CALL_NO_LINE,         // Call list line does not match
+};
+
 /**
  * @brief Filter information
  */
@@ -95,6 +110,19 @@ filter_set(enum FilterType type, const gchar *expr);
 const gchar *
 filter_get(enum FilterType type);
 
+/**
+ * @brief Set the attributes displayed in each call list line
+ *
+ * Call list filter is checked against the first message values of these
+ * attributes. A copy of the array is stored, so call list columns can
+ * change without affecting filters until this is called again.
+ * Storage lock must be held while calling this function.
+ *
+ * @param attributes Array of attributes (Attribute *) or NULL
+ */
+void
+filter_set_line_attributes(GPtrArray *attributes);
+
 /**
  * @brief Check if a call if filtered
  *
@@ -104,6 +132,33 @@ filter_get(enum FilterType type);
 gboolean
 filter_check_call(Call *call, gconstpointer user_data);
 
+/**
+ * @brief Check if a call still matches filters after adding a message
+ *
+ * Only the filters that can change with the new message are checked:
+ * payload filter is checked against the new message payload and call
+ * list filter is checked again.
+ *
+ * @param call Call to be checked
+ * @param msg Message added to the call
+ * @return TRUE if call matches all filters
+ */
+gboolean
+filter_check_call_message(Call *call, Message *msg);
+
+/**
+ * @brief Check if a value matches the filter of the given type
+ *
+ * This is used to check indexed call attributes values once for
+ * all the calls sharing the same value.
+ *
+ * @param type Type of the filter
+ * @param value Attribute value to be checked
+ * @return TRUE if the filter is not set or the value matches it
+ */
+gboolean
+filter_check_value(enum FilterType type, const gchar *value);
+
 /**
  * @brief Check if data matches the filter regexp
  *
@@ -112,11 +167,29 @@ filter_check_call(Call *call, gconstpointer user_data);
 gint
 filter_check_expr(Filter filter, const gchar *data);
 
+/**
+ * @brief Check if a length delimited data matches the filter regexp
+ *
+ * @return 0 if the given data matches the filter
+ */
+gint
+filter_check_expr_len(Filter filter, const gchar *data, gsize len);
+
+/**
+ * @brief Reset filtered flag of a call
+ *
+ * Filters will be evaluated again next time the call is checked.
+ *
+ * @param call Call to be checked again
+ */
+void
+filter_reset_call(Call *call);
+
 /**
  * @brief Reset filtered flag in all calls
  *
- * This function can be used to force reevaluation
- * of filters in all calls.
+ * This function must be called after changing any filter expression
+ * to reevaluate filters in all calls and rebuild displayed calls.
  */
 void
 filter_reset_calls();
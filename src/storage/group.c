@@ -31,6 +31,7 @@
 #include <string.h>
 #include "glib-extra/glib.h"
 #include "group.h"
+#include "storage.h"
 #include "setting.h"
 
 CallGroup *
@@ -40,6 +41,7 @@ call_group_new()
     group->calls = g_ptr_array_new();
     group->msgs = g_ptr_array_new();
     group->streams = g_ptr_array_new();
+    group->generations = g_hash_table_new(g_direct_hash, g_direct_equal);
     return group;
 }
 
@@ -50,6 +52,7 @@ call_group_free(CallGroup *group)
     g_ptr_array_free(group->calls, FALSE);
     g_ptr_array_free(group->msgs, FALSE);
     g_ptr_array_free(group->streams, FALSE);
+    g_hash_table_destroy(group->generations);
     g_free(group);
 }
 
@@ -60,8 +63,11 @@ call_group_add(CallGroup *group, Call *call)
     g_return_if_fail(call != NULL);
 
     if (!call_group_exists(group, call)) {
+        // Displayed calls contents are kept in memory
+        storage_call_thaw(call);
         call->locked = TRUE;
         g_ptr_array_add(group->calls, call);
+        g_hash_table_insert(group->generations, call, GUINT_TO_POINTER(call->generation));
         g_ptr_array_add_array(group->msgs, call->msgs);
         g_ptr_array_add_array(group->streams, call->streams);
     }
@@ -90,6 +96,7 @@ call_group_remove(CallGroup *group, Call *call)
 
     // Remove the call from the group
     g_ptr_array_remove(group->calls, call);
+    g_hash_table_remove(group->generations, call);
     g_ptr_array_remove_array(group->msgs, call->msgs);
     g_ptr_array_remove_array(group->streams, call->streams);
 }
@@ -101,6 +108,7 @@ call_group_remove_all(CallGroup *group)
     g_ptr_array_remove_all(group->calls);
     g_ptr_array_remove_all(group->msgs);
     g_ptr_array_remove_all(group->streams);
+    g_hash_table_remove_all(group->generations);
 }
 
 gboolean
@@ -116,13 +124,14 @@ call_group_changed(CallGroup *group)
     gboolean changed = FALSE;
 
     // Check if any of the group has changed
-    // We check all the calls even after we found a changed one to reset all
-    // the changed pointers
+    // We check all the calls even after we found a changed one to update all
+    // the checked generations
     for (guint i = 0; i < g_ptr_array_len(group->calls); i++) {
         Call *call = g_ptr_array_index(group->calls, i);
-        if (call->changed) {
-            // Reset the change flag
-            call->changed = FALSE;
+        guint generation = GPOINTER_TO_UINT(g_hash_table_lookup(group->generations, call));
+        if (call->generation != generation) {
+            // Remember the checked generation
+            g_hash_table_insert(group->generations, call, GUINT_TO_POINTER(call->generation));
             // Mark the group as changed
             changed = TRUE;
 
@@ -159,6 +168,14 @@ call_group_clone(CallGroup *original)
     clone->calls = g_ptr_array_deep_copy(original->calls);
     clone->msgs = g_ptr_array_deep_copy(original->msgs);
     clone->streams = g_ptr_array_deep_copy(original->streams);
+    clone->generations = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    GHashTableIter iter;
+    gpointer call, generation;
+    g_hash_table_iter_init(&iter, original->generations);
+    while (g_hash_table_iter_next(&iter, &call, &generation)) {
+        g_hash_table_insert(clone->generations, call, generation);
+    }
     return clone;
 }
 
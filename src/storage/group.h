@@ -56,6 +56,8 @@ struct _SipCallGroup
     GPtrArray *msgs;
     //! Streams in the group
     GPtrArray *streams;
+    //! Last checked generation of each call in the group (Call * -> guint)
+    GHashTable *generations;
     //! Only consider SDP messages from Calls
     gint sdp_only;
 };
@@ -81,8 +83,9 @@ call_group_free(CallGroup *group);
 /**
  * @brief Check if any of the calls of the group has changed
  *
- * This checks all the group flags to check if any of the call has
- * changed.
+ * This compares the generation of each call of the group with the
+ * generation the last time this group was checked, so each group tracks
+ * its own changes without modifying the calls.
  *
  * @param group Call group structure pointer
  * @return true if any of the calls of the group has changed, false otherwise
@@ -0,0 +1,114 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file intern.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in intern.h
+ *
+ */
+#include "config.h"
+#include <string.h>
+#include <glib.h>
+#include "intern.h"
+
+//! Shorter declaration of interned string structure
+typedef struct _InternAtom InternAtom;
+
+/**
+ * @brief Interned string with its reference counter
+ */
+struct _InternAtom
+{
+    //! Number of references to this string
+    gint refcount;
+    //! String contents
+    gchar str[];
+};
+
+//! Interned strings indexed by their contents
+static GHashTable *atoms = NULL;
+//! Lock for interned strings table
+static GMutex atoms_lock;
+
+/**
+ * @brief Get the atom structure of an interned string
+ */
+static InternAtom *
+intern_atom(const gchar *str)
+{
+    return (InternAtom *) (str - G_STRUCT_OFFSET(InternAtom, str));
+}
+
+const gchar *
+intern_string(const gchar *str)
+{
+    if (str == NULL)
+        return NULL;
+
+    g_mutex_lock(&atoms_lock);
+    if (atoms == NULL) {
+        atoms = g_hash_table_new(g_str_hash, g_str_equal);
+    }
+
+    InternAtom *atom = g_hash_table_lookup(atoms, str);
+    if (atom != NULL) {
+        g_atomic_int_inc(&atom->refcount);
+    } else {
+        gsize len = strlen(str) + 1;
+        atom = g_malloc(sizeof(InternAtom) + len);
+        atom->refcount = 1;
+        memcpy(atom->str, str, len);
+        g_hash_table_insert(atoms, atom->str, atom);
+    }
+    g_mutex_unlock(&atoms_lock);
+
+    return atom->str;
+}
+
+const gchar *
+intern_ref(const gchar *str)
+{
+    if (str == NULL)
+        return NULL;
+
+    // Caller already holds a reference, so the atom can not be released
+    g_atomic_int_inc(&intern_atom(str)->refcount);
+    return str;
+}
+
+void
+intern_unref(const gchar *str)
+{
+    if (str == NULL)
+        return;
+
+    InternAtom *atom = intern_atom(str);
+
+    // Lookups can add references while holding the lock
+    g_mutex_lock(&atoms_lock);
+    if (g_atomic_int_dec_and_test(&atom->refcount)) {
+        g_hash_table_remove(atoms, atom->str);
+        g_free(atom);
+    }
+    g_mutex_unlock(&atoms_lock);
+}
@@ -0,0 +1,71 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file intern.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage shared immutable strings
+ *
+ * Interned strings are stored once no matter how many times they are
+ * requested. Each distinct value has a reference counter and it's
+ * released when its last reference is removed. Two interned strings
+ * are equal only if they are the same pointer.
+ *
+ */
+
+#ifndef __SNGREP_INTERN_H
+#define __SNGREP_INTERN_H
+
+#include <glib.h>
+
+/**
+ * @brief Get the interned copy of a string
+ *
+ * A new reference to the interned string is returned, it must be
+ * released using intern_unref.
+ *
+ * @param str String to intern (can be NULL)
+ * @return interned string or NULL
+ */
+const gchar *
+intern_string(const gchar *str);
+
+/**
+ * @brief Add a new reference to an interned string
+ *
+ * @param str Interned string (can be NULL)
+ * @return same interned string
+ */
+const gchar *
+intern_ref(const gchar *str);
+
+/**
+ * @brief Remove a reference to an interned string
+ *
+ * Interned string memory is released when it has no references.
+ *
+ * @param str Interned string (can be NULL)
+ */
+void
+intern_unref(const gchar *str);
+
+#endif /* __SNGREP_INTERN_H */
@@ -29,6 +29,7 @@
  *
  */
 #include "config.h"
+#include <string.h>
 #include <glib.h>
 #include "glib-extra/glib.h"
 #include "message.h"
@@ -38,15 +39,20 @@
 #include "storage/storage.h"
 
 Message *
-msg_new(Packet *packet)
+msg_new(Call *call, Packet *packet)
 {
-    Message *msg = g_malloc0(sizeof(Message));
+    g_return_val_if_fail(call != NULL, NULL);
+
+    Message *msg = arena_alloc0(call->arena, sizeof(Message));
+    // Set message owner
+    msg->call = call;
     // Set message packet
     msg->packet = packet_ref(packet);
-    // Create message attribute list
+    // Attribute values are allocated on first request
     msg->attributes = NULL;
-    // Mark retransmission flag as not checked
-    msg->retrans = -1;
+    msg->attributes_len = 0;
+    // Retransmission original is set when message is added to the call
+    msg->retrans = NULL;
 
     // Message from SIP packet
     if (packet_has_protocol(packet, PACKET_PROTO_SIP)) {
@@ -56,8 +62,9 @@ msg_new(Packet *packet)
         msg->method = packet_sip_method(packet);
         msg->method_str =  packet_sip_method_str(packet);
         msg->cseq = packet_sip_cseq(packet);
-        msg->payload = packet_sip_payload_str(packet);
         msg->auth = packet_sip_auth_data(msg->packet);
+        msg->payload_hash = packet_sip_payload_hash(packet);
+        msg->payload_len = packet_sip_payload_len(packet);
     }
 
     // Message from MRCP arrow
@@ -66,8 +73,9 @@ msg_new(Packet *packet)
         msg->isrequest = packet_mrcp_is_request(packet);
         msg->method = packet_mrcp_method(packet);
         msg->method_str = packet_mrcp_method_str(packet);
-        msg->payload = packet_mrcp_payload_str(packet);
         msg->cseq = packet_mrcp_request_id(packet);
+        msg->payload_hash = packet_mrcp_payload_hash(packet);
+        msg->payload_len = packet_mrcp_payload_len(packet);
     }
 
     return msg;
@@ -78,8 +86,13 @@ msg_free(Message *msg)
 {
     // Free message packets
     packet_unref(msg->packet);
-    g_slist_free_full(msg->attributes, (GDestroyNotify) attribute_value_free);
-    g_free(msg);
+    // Free mutable attribute values, the rest are released with the call arena
+    for (guint i = 0; i < msg->attributes_len; i++) {
+        Attribute *attr = attribute_find_by_id(i);
+        if (attr != NULL && attr->mutable) {
+            g_free(msg->attributes[i].value);
+        }
+    }
 }
 
 Call *
@@ -166,10 +179,33 @@ msg_get_cseq(Message *msg)
     return msg->cseq;
 }
 
-gchar *
+GBytes *
 msg_get_payload(Message *msg)
 {
-    return g_strdup(msg->payload);
+    // Message from SIP packet
+    if (packet_has_protocol(msg->packet, PACKET_PROTO_SIP)) {
+        return packet_sip_payload(msg->packet);
+    }
+
+    // Message from MRCP packet
+    if (packet_has_protocol(msg->packet, PACKET_PROTO_MRCP)) {
+        return packet_mrcp_payload(msg->packet);
+    }
+
+    return NULL;
+}
+
+gchar *
+msg_get_payload_str(Message *msg)
+{
+    g_autoptr(GBytes) payload = msg_get_payload(msg);
+    if (payload == NULL)
+        return NULL;
+
+    return g_strndup(
+        g_bytes_get_data(payload, NULL),
+        g_bytes_get_size(payload)
+    );
 }
 
 guint64
@@ -180,44 +216,72 @@ msg_get_time(const Message *msg)
     return packet_time(msg->packet);
 }
 
-const gchar *
-msg_get_attribute(Message *msg, Attribute *attr)
+/**
+ * @brief Get the message value slot of the given attribute
+ */
+static AttributeValue *
+msg_attribute_slot(Message *msg, Attribute *attr)
 {
-    AttributeValue *cached_value = NULL;
-
-    //! Check if this attribute was already requested
-    for (GSList *l = msg->attributes; l != NULL; l = l->next) {
-        AttributeValue *value = l->data;
-        g_return_val_if_fail(value != NULL, NULL);
-        if (value->attr == attr) {
-            cached_value = value;
-            break;
+    //! Allocate value slots for all registered attributes
+    if (attr->id >= msg->attributes_len) {
+        guint len = MAX(attribute_count(), attr->id + 1);
+        AttributeValue *attributes = arena_alloc0(msg->call->arena, len * sizeof(AttributeValue));
+        if (msg->attributes_len > 0) {
+            memcpy(attributes, msg->attributes, msg->attributes_len * sizeof(AttributeValue));
         }
+        msg->attributes = attributes;
+        msg->attributes_len = len;
     }
 
-    if (cached_value != NULL) {
-        if (!attr->mutable) {
-            //! Attribute value doesn't change, return cached value
-            return cached_value->value;
-        } else {
-            //! Attribute value changes, cached value is obsolete
-            msg->attributes = g_slist_remove(msg->attributes, cached_value);
-            attribute_value_free(cached_value);
-        }
+    return &msg->attributes[attr->id];
+}
+
+const gchar *
+msg_get_attribute(Message *msg, Attribute *attr)
+{
+    g_return_val_if_fail(msg != NULL, NULL);
+    g_return_val_if_fail(attr != NULL, NULL);
+
+    //! Mutable attribute values are valid until owner call changes
+    guint generation = 0;
+    if (attr->mutable && msg->call != NULL) {
+        generation = msg->call->generation;
     }
 
-    //! Get current attribute value
-    cached_value = attribute_value_new(
-        attr,
-        attribute_get_value(attr, msg)
-    );
+    AttributeValue *cached_value = msg_attribute_slot(msg, attr);
+    if (cached_value->cached && cached_value->generation == generation) {
+        return cached_value->value;
+    }
 
-    //! Store value in attribute cache for future requests
-    msg->attributes = g_slist_append(msg->attributes, cached_value);
+    //! Get current attribute value and store it for future requests
+    if (attr->mutable) {
+        g_free(cached_value->value);
+        cached_value->value = attribute_get_value(attr, msg);
+    } else {
+        g_autofree gchar *value = attribute_get_value(attr, msg);
+        cached_value->value = arena_strdup(msg->call->arena, value);
+    }
+    cached_value->generation = generation;
+    cached_value->cached = TRUE;
 
     return cached_value->value;
 }
 
+void
+msg_set_attribute(Message *msg, Attribute *attr, gchar *value)
+{
+    g_return_if_fail(msg != NULL);
+    g_return_if_fail(msg->call != NULL);
+    g_return_if_fail(attr != NULL);
+    g_return_if_fail(!attr->mutable);
+
+    AttributeValue *cached_value = msg_attribute_slot(msg, attr);
+    cached_value->value = arena_strdup(msg->call->arena, value);
+    g_free(value);
+    cached_value->generation = 0;
+    cached_value->cached = TRUE;
+}
+
 const gchar *
 msg_get_preferred_codec_alias(Message *msg)
 {
@@ -238,59 +302,64 @@ msg_get_header(Message *msg, char *out)
 {
     // Get msg header
     sprintf(out, "%s %s %s -> %s",
-            msg_get_attribute(msg, attribute_find_by_name(ATTR_DATE)),
-            msg_get_attribute(msg, attribute_find_by_name(ATTR_TIME)),
-            msg_get_attribute(msg, attribute_find_by_name(ATTR_SRC)),
-            msg_get_attribute(msg, attribute_find_by_name(ATTR_DST))
+            msg_get_attribute(msg, attribute_find_by_id(ATTR_ID_DATE)),
+            msg_get_attribute(msg, attribute_find_by_id(ATTR_ID_TIME)),
+            msg_get_attribute(msg, attribute_find_by_id(ATTR_ID_SRC)),
+            msg_get_attribute(msg, attribute_find_by_id(ATTR_ID_DST))
     );
     return out;
 }
 
+guint
+msg_hash(gconstpointer msg)
+{
+    const Message *m = msg;
+    return (guint) (m->payload_hash ^ (m->payload_hash >> 32));
+}
+
 gboolean
-msg_is_retransmission(Message *msg)
+msg_equal(gconstpointer a, gconstpointer b)
 {
-    if (msg->retrans == -1) {
-        // Try to find the original message
-        const Message *original = msg_get_retransmission_original(msg);
-        msg->retrans = (original != NULL) ? 1 : 0;
+    const Message *one = a, *two = b;
+    return one->payload_hash == two->payload_hash
+           && one->payload_len == two->payload_len
+           && addressport_equals(packet_src_address(one->packet), packet_src_address(two->packet))
+           && addressport_equals(packet_dst_address(one->packet), packet_dst_address(two->packet));
+}
+
+gboolean
+msg_payload_equal(Message *one, Message *two)
+{
+    g_autoptr(GBytes) first = msg_get_payload(one);
+    g_autoptr(GBytes) second = msg_get_payload(two);
+    if (first == NULL || second == NULL)
+        return FALSE;
+
+    gsize len = 0;
+    const gchar *data = g_bytes_get_data(first, &len);
+    if (len != g_bytes_get_size(second))
+        return FALSE;
+
+    // Payloads hash is case insensitive too
+    const gchar *other = g_bytes_get_data(second, NULL);
+    for (gsize i = 0; i < len; i++) {
+        if (g_ascii_tolower(data[i]) != g_ascii_tolower(other[i]))
+            return FALSE;
     }
 
-    return (msg->retrans == 0) ? FALSE : TRUE;
+    return TRUE;
+}
+
+gboolean
+msg_is_retransmission(Message *msg)
+{
+    return msg->retrans != NULL;
 }
 
 const Message *
 msg_get_retransmission_original(Message *msg)
 {
-    // Look in the 20 previous messages for a retrans of current message
-    guint length = g_ptr_array_len(msg->call->msgs);
-    for (guint i = 0; i < 20; i++) {
-        // Stop if we have checked all items
-        if (i >= length)
-            break;
-
-        // Get the Nth item from the tail
-        Message *prev = g_ptr_array_index(msg->call->msgs, length - 1 - i);
-
-        // Skip yourself
-        if (prev == msg) continue;
-
-        // Check source and destination addresses are equal
-        if (addressport_equals(msg_src_address(prev), msg_src_address(msg)) &&
-            addressport_equals(msg_dst_address(prev), msg_dst_address(msg))) {
-            // Check they have the same payload
-            gchar *payload_msg = msg_get_payload(msg);
-            gchar *payload_prev = msg_get_payload(prev);
-            if (!strcasecmp(payload_msg, payload_prev)) {
-                g_free(payload_msg);
-                g_free(payload_prev);
-                return prev;
-            }
-            g_free(payload_msg);
-            g_free(payload_prev);
-        }
-    }
-
-    return NULL;
+    return msg->retrans;
 }
 
 gboolean
@@ -299,16 +368,11 @@ msg_is_duplicate(Message *msg)
     if (!msg_is_retransmission(msg))
         return FALSE;
 
-    g_autoptr(GDateTime) orig_ts = g_date_time_new_from_unix_usec(
-        msg_get_time(msg_get_retransmission_original(msg))
-    );
-
-    g_autoptr(GDateTime) retrans_ts = g_date_time_new_from_unix_usec(
-        msg_get_time(msg)
-    );
+    gint64 orig_ts = (gint64) msg_get_time(msg->retrans);
+    gint64 retrans_ts = (gint64) msg_get_time(msg);
 
     // Consider duplicate if difference with its original is 10ms or less
-    return g_date_time_difference(retrans_ts, orig_ts) > 10000;
+    return retrans_ts - orig_ts > 10000;
 }
 
 const gchar *
@@ -54,8 +54,10 @@ struct _Message
     Call *call;
     //! Captured packet for this message
     Packet *packet;
-    //! Attribute list for this message
-    GSList *attributes;
+    //! Cached attribute values for this message indexed by attribute id
+    AttributeValue *attributes;
+    //! Number of allocated attribute values
+    guint attributes_len;
     //! Message is part of initial transaciton
     gboolean initial;
     //! Message is a request?
@@ -66,12 +68,14 @@ struct _Message
     const gchar *method_str;
     //! CSeq Number
     guint64 cseq;
-    //! Message payload pointer
-    const gchar *payload;
     //! Message auth data
     const gchar *auth;
-    //! Message is a retransmission from other message
-    gint retrans;
+    //! Case insensitive hash of message payload
+    guint64 payload_hash;
+    //! Message payload length
+    gsize payload_len;
+    //! Previous message with the same addresses and payload (NULL if none)
+    Message *retrans;
 };
 
 
@@ -82,11 +86,14 @@ struct _Message
  * will only store the given information, but wont parse it until
  * needed.
  *
+ * Message is allocated in the call memory arena.
+ *
+ * @param call Call owner of the message
  * @param packet Packet containing SIP message data
  * @return a new allocated message
  */
 Message *
-msg_new(Packet *packet);
+msg_new(Call *call, Packet *packet);
 
 /**
  * @brief Destroy a SIP message and free its memory
@@ -193,10 +200,22 @@ msg_get_cseq(Message *msg);
 /**
  * @brief Get SIP Message payload
  *
+ * Payload bytes are shared with the message packet, no data is copied.
+ * Returned reference must be released when not longer required.
+ *
+ * @param msg SIP message
+ * @return payload bytes reference or NULL
+ */
+GBytes *
+msg_get_payload(Message *msg);
+
+/**
+ * @brief Get SIP Message payload as a null terminated string
+ *
  * Payload data must be freed when not longer required
  */
 gchar *
-msg_get_payload(Message *msg);
+msg_get_payload_str(Message *msg);
 
 /**
  * @brief Get Time of message from packet header
@@ -220,6 +239,19 @@ msg_get_time(const Message *msg);
 const gchar *
 msg_get_attribute(Message *msg, Attribute *attr);
 
+/**
+ * @brief Store an already calculated attribute value
+ *
+ * Only valid for non mutable attributes. Stored value will be returned
+ * by msg_get_attribute without calling the attribute getter.
+ *
+ * @param msg SIP message structure
+ * @param attr Attribute pointer
+ * @param value Attribute value (the message takes ownership) or NULL
+ */
+void
+msg_set_attribute(Message *msg, Attribute *attr, gchar *value);
+
 const gchar *
 msg_get_preferred_codec_alias(Message *msg);
 
@@ -236,11 +268,47 @@ msg_get_preferred_codec_alias(Message *msg);
 const gchar *
 msg_get_header(Message *msg, gchar *out);
 
+/**
+ * @brief Hash a message by its source, destination and payload
+ *
+ * Hash function to be used in hash tables with Message keys
+ *
+ * @param msg Message pointer
+ * @return hash value of message addresses and payload
+ */
+guint
+msg_hash(gconstpointer msg);
+
+/**
+ * @brief Check if two messages have the same source, destination and payload
+ *
+ * Equal function to be used in hash tables with Message keys. Payloads are
+ * compared using their hash and length calculated while dissecting, use
+ * msg_payload_equal to confirm they are actually equal.
+ *
+ * @param a Message pointer
+ * @param b Message pointer
+ * @return TRUE if both messages have the same addresses and payload
+ */
+gboolean
+msg_equal(gconstpointer a, gconstpointer b);
+
+/**
+ * @brief Check if two messages payloads are equal ignoring ASCII case
+ *
+ * @param one Message pointer
+ * @param two Message pointer
+ * @return TRUE if both payloads have the same contents
+ */
+gboolean
+msg_payload_equal(Message *one, Message *two);
+
 /**
  * @brief Check if given message is a retransmission
  *
- * Compare message payload with the previous messages in the dialog,
- * to check if it one has the same content.
+ * A message is a retransmission if a previous message in the dialog has
+ * the same addresses and content. This is checked when the message is
+ * added to its call.
  *
  * @param msg SIP Message
  * @return TRUE is message is a Retransmission, FALSE otherwise
@@ -249,10 +317,7 @@ gboolean
 msg_is_retransmission(Message *msg);
 
 /**
- * @brief Check if given message is a retransmission
- *
- * Compare message payload with the previous messages in the dialog,
- * to check if it one has the same content.
+ * @brief Get the message this message is a retransmission of
  *
  * @param msg SIP Message
  * @return pointer to original message or NULL if message is not a retransmission
@@ -32,6 +32,8 @@
  *  - Sorts and manage calls lists
  *  - Sends interesting packets to capture outputs
  *  - Manages how packets are stored
+ *  - Processes queued packets in its own thread, publishing a new version
+ *    of stored calls for the interface after each change
  *
  *             +--------------------------+
  *             |                          |
@@ -54,7 +56,8 @@
  */
 
 #include "config.h"
-#include <malloc.h>
+#include <string.h>
+#include <arpa/inet.h>
 #include <glib.h>
 #include "glib-extra/glib.h"
 #include "packet/dissector.h"
@@ -63,75 +66,1257 @@
 #include "setting.h"
 #include "filter.h"
 #include "storage.h"
-#include "tui/tui.h"
-#include "tui/dialog.h"
+#include "storage_disk.h"
+#include "storage_cold.h"
+#include "intern.h"
 
 /**
  * @brief Global Structure with all storage information
  */
 static Storage *storage;
 
+/**
+ * @brief Accounted memory bytes for each subsystem
+ */
+static gssize storage_memory[STORAGE_MEMORY_COUNT];
+
+/**
+ * @brief Attributes of calls secondary indexes
+ */
+static const AttributeId storage_index_attributes[CALL_INDEX_COUNT] = {
+    [CALL_INDEX_SIPFROM] = ATTR_ID_SIPFROM,
+    [CALL_INDEX_SIPTO] = ATTR_ID_SIPTO,
+    [CALL_INDEX_SRC] = ATTR_ID_SRC,
+    [CALL_INDEX_DST] = ATTR_ID_DST,
+};
+
+/**
+ * @brief Display filters matching calls secondary indexes attributes
+ */
+static const enum FilterType storage_index_filters[CALL_INDEX_COUNT] = {
+    [CALL_INDEX_SIPFROM] = FILTER_SIPFROM,
+    [CALL_INDEX_SIPTO] = FILTER_SIPTO,
+    [CALL_INDEX_SRC] = FILTER_SOURCE,
+    [CALL_INDEX_DST] = FILTER_DESTINATION,
+};
+
 static gint
-storage_call_attr_sorter(const Call **a, const Call **b)
+storage_call_sorter(gconstpointer a, gconstpointer b, G_GNUC_UNUSED gpointer user_data)
 {
-    gint cmp = call_attr_compare(*a, *b, storage->options.sort.by);
+    gint cmp = call_sort_key_compare(a, b);
     return (storage->options.sort.asc) ? cmp : cmp * -1;
 }
 
+/**
+ * @brief Add a new call to the sorted calls sequence
+ *
+ * @param call Call with at least one message
+ */
+static void
+storage_calls_sort_insert(Call *call)
+{
+    call_sort_key_update(call, storage->options.sort.by);
+    call->sort_iter = g_sequence_insert_sorted(storage->calls_sorted, call, storage_call_sorter, NULL);
+    storage->sort_changed = TRUE;
+}
+
+/**
+ * @brief Move a call in the sorted calls sequence if its sort key changed
+ *
+ * Only mutable attributes values can change after the call is created.
+ *
+ * @param call Call that has been updated
+ */
+static void
+storage_calls_sort_update(Call *call)
+{
+    if (!storage->options.sort.by->mutable)
+        return;
+
+    if (call_sort_key_update(call, storage->options.sort.by)) {
+        g_sequence_sort_changed(call->sort_iter, storage_call_sorter, NULL);
+        if (call->display_iter != NULL) {
+            g_sequence_sort_changed(call->display_iter, storage_call_sorter, NULL);
+        }
+        storage->sort_changed = TRUE;
+    }
+}
+
+/**
+ * @brief Evaluate display filters of a new or changed call
+ *
+ * The call is added or removed from displayed calls depending on
+ * the filters result.
+ *
+ * @param call Call that has been added or updated
+ * @param msg Message added to the call
+ */
+static void
+storage_calls_display_update(Call *call, Message *msg)
+{
+    if (filter_check_call_message(call, msg)) {
+        if (call->display_iter == NULL) {
+            call->display_iter = g_sequence_insert_sorted(
+                storage->calls_displayed, call, storage_call_sorter, NULL
+            );
+        }
+    } else if (call->display_iter != NULL) {
+        g_sequence_remove(call->display_iter);
+        call->display_iter = NULL;
+    }
+}
+
+static gint
+storage_call_time_sorter(gconstpointer a, gconstpointer b, G_GNUC_UNUSED gpointer user_data)
+{
+    const Call *one = a, *two = b;
+
+    if (one->start_time != two->start_time)
+        return (one->start_time > two->start_time) ? 1 : -1;
+
+    // Calls started at the same time keep their creation order
+    return (one->index > two->index) - (one->index < two->index);
+}
+
+/**
+ * @brief Add a new call to the secondary indexes
+ *
+ * Indexed values are taken from the call first message, the same
+ * message display filters are checked against.
+ *
+ * @param call Call with at least one message
+ */
+static void
+storage_calls_index_insert(Call *call)
+{
+    Message *msg = g_ptr_array_first(call->msgs);
+
+    // Call index lookup table for payload index results
+    if (storage->calls_index != NULL) {
+        g_hash_table_insert(storage->calls_index, GUINT_TO_POINTER(call->index), call);
+    }
+
+    // Start time index
+    call->start_time = msg_get_time(msg);
+    call->time_iter = g_sequence_insert_sorted(storage->calls_time, call, storage_call_time_sorter, NULL);
+
+    // Attribute values indexes
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        const gchar *value = msg_get_attribute(msg, attribute_find_by_id(storage_index_attributes[i]));
+        if (value == NULL)
+            continue;
+
+        call->index_keys[i] = intern_string(value);
+        GQueue *calls = g_hash_table_lookup(storage->indexes[i], call->index_keys[i]);
+        if (calls == NULL) {
+            calls = g_queue_new();
+            g_hash_table_insert(storage->indexes[i], (gpointer) intern_ref(call->index_keys[i]), calls);
+        }
+        call->index_links[i].data = call;
+        g_queue_push_tail_link(calls, &call->index_links[i]);
+    }
+}
+
+/**
+ * @brief Remove a call from the secondary indexes
+ *
+ * @param call Call to be removed
+ */
+static void
+storage_calls_index_remove(Call *call)
+{
+    if (storage->calls_index != NULL) {
+        g_hash_table_remove(storage->calls_index, GUINT_TO_POINTER(call->index));
+    }
+
+    g_sequence_remove(call->time_iter);
+    call->time_iter = NULL;
+
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        if (call->index_keys[i] == NULL)
+            continue;
+
+        GQueue *calls = g_hash_table_lookup(storage->indexes[i], call->index_keys[i]);
+        g_queue_unlink(calls, &call->index_links[i]);
+        if (g_queue_is_empty(calls)) {
+            g_hash_table_remove(storage->indexes[i], call->index_keys[i]);
+        }
+    }
+}
+
+static gboolean
+storage_calls_index_contains(guint32 index, Call *call)
+{
+    // Current call may not be indexed yet
+    return call->index == index
+           || g_hash_table_contains(storage->calls_index, GUINT_TO_POINTER(index));
+}
+
+/**
+ * @brief Create a new empty payload trigram index
+ *
+ * Calls stored before the index is created are not indexed, so they
+ * are always payload filter candidates until they are removed.
+ */
+static void
+storage_payload_index_reset()
+{
+    if (!storage->options.capture.payload_index)
+        return;
+
+    if (storage->payload_index != NULL) {
+        storage_trigram_index_clear(storage->payload_index);
+    } else {
+        storage->payload_index = storage_trigram_index_new();
+    }
+
+    storage->payload_index_first = storage->last_index + 1;
+}
+
+/**
+ * @brief Add a new message payload to the payload trigram index
+ *
+ * When the index reaches its memory limit, removed calls are purged from
+ * it. If that does not release enough memory, the index is disabled and
+ * payload filters will check all calls until calls are removed.
+ *
+ * @param msg Message added to a call
+ */
+static void
+storage_payload_index_add(Message *msg)
+{
+    if (storage->payload_index == NULL)
+        return;
+
+    g_autoptr(GBytes) payload = msg_get_payload(msg);
+    if (payload == NULL)
+        return;
+
+    gsize len = 0;
+    const gchar *data = g_bytes_get_data(payload, &len);
+    storage_trigram_index_add(storage->payload_index, msg->call->index, data, len);
+
+    gsize limit = storage->options.capture.payload_index_limit;
+    if (limit == 0 || storage->payload_index->size <= limit)
+        return;
+
+    storage_trigram_index_prune(
+        storage->payload_index,
+        (StorageTrigramKeepFunc) storage_calls_index_contains,
+        msg->call
+    );
+
+    // Release some extra memory to avoid purging on every message
+    if (storage->payload_index->size > limit / 10 * 9) {
+        storage_trigram_index_free(storage->payload_index);
+        storage->payload_index = NULL;
+    }
+}
+
+/**
+ * @brief Get the calls that can match current payload filter
+ *
+ * The longest literal text required by the payload filter expression is
+ * searched in the payload trigram index.
+ *
+ * @return array of calls (Call *) or NULL if payload index can not be used
+ */
+static GPtrArray *
+storage_calls_payload_candidates()
+{
+    const gchar *expr = filter_get(FILTER_PAYLOAD);
+    if (storage->payload_index == NULL || expr == NULL)
+        return NULL;
+
+    // Display filters are case insensitive
+    gboolean exact;
+    g_autofree gchar *literal = storage_match_literal(expr, TRUE, FALSE, &exact);
+    if (literal == NULL)
+        return NULL;
+
+    GArray *indexes = storage_trigram_index_lookup(storage->payload_index, literal, strlen(literal));
+    if (indexes == NULL)
+        return NULL;
+
+    GPtrArray *candidates = g_ptr_array_sized_new(indexes->len);
+
+    // Calls stored before the index was created are not indexed
+    for (GList *l = storage->calls_order.head; l != NULL; l = l->next) {
+        Call *call = l->data;
+        if (call->index >= storage->payload_index_first)
+            break;
+        g_ptr_array_add(candidates, call);
+    }
+
+    for (guint i = 0; i < indexes->len; i++) {
+        guint32 index = g_array_index(indexes, guint32, i);
+        if (index < storage->payload_index_first)
+            continue;
+
+        Call *call = g_hash_table_lookup(storage->calls_index, GUINT_TO_POINTER(index));
+        // Removed calls are kept in the index until it is pruned
+        if (call != NULL) {
+            g_ptr_array_add(candidates, call);
+        }
+    }
+    g_array_free(indexes, TRUE);
+
+    return candidates;
+}
+
+/**
+ * @brief Get the calls that can match current display filters
+ *
+ * Display filters of indexed attributes are checked once for each distinct
+ * indexed value instead of once for each call. Payload filter is checked
+ * against the payload trigram index, if enabled. When more than one index
+ * can be used, the one with less matching calls is used.
+ *
+ * @return array of calls (Call *) or NULL if no index can be used
+ */
+static GPtrArray *
+storage_calls_index_candidates()
+{
+    g_autoptr(GPtrArray) best = NULL;
+    guint best_count = 0;
+
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        if (filter_get(storage_index_filters[i]) == NULL)
+            continue;
+
+        GPtrArray *matches = g_ptr_array_new();
+        guint count = 0;
+
+        GHashTableIter iter;
+        gpointer value, calls;
+        g_hash_table_iter_init(&iter, storage->indexes[i]);
+        while (g_hash_table_iter_next(&iter, &value, &calls)) {
+            if (filter_check_value(storage_index_filters[i], value)) {
+                g_ptr_array_add(matches, calls);
+                count += g_queue_get_length(calls);
+            }
+        }
+
+        // Keep the most selective index
+        if (best == NULL || count < best_count) {
+            g_clear_pointer(&best, g_ptr_array_unref);
+            best = matches;
+            best_count = count;
+        } else {
+            g_ptr_array_free(matches, TRUE);
+        }
+    }
+
+    GPtrArray *candidates = storage_calls_payload_candidates();
+    if (candidates != NULL && (best == NULL || candidates->len <= best_count))
+        return candidates;
+
+    if (candidates != NULL) {
+        g_ptr_array_free(candidates, TRUE);
+    }
+
+    if (best == NULL)
+        return NULL;
+
+    // Get all calls of the matching values
+    candidates = g_ptr_array_sized_new(best_count);
+    for (guint i = 0; i < g_ptr_array_len(best); i++) {
+        GQueue *calls = g_ptr_array_index(best, i);
+        for (GList *l = calls->head; l != NULL; l = l->next) {
+            g_ptr_array_add(candidates, l->data);
+        }
+    }
+
+    return candidates;
+}
+
+GSequence *
+storage_calls_displayed()
+{
+    return storage->calls_displayed;
+}
+
+/**
+ * @brief Free a displayed call snapshot values
+ */
+static void
+storage_snapshot_call_free(StorageSnapshotCall *scall)
+{
+    g_ptr_array_free(scall->values, TRUE);
+    g_free(scall);
+}
+
+StorageSnapshot *
+storage_calls_snapshot(guint offset, guint count, GPtrArray *attributes)
+{
+    StorageSnapshot *snapshot = g_malloc0(sizeof(StorageSnapshot));
+    snapshot->stats = storage_calls_stats();
+    snapshot->memory_usage = storage_memory_usage();
+    snapshot->offset = offset;
+    snapshot->calls = g_ptr_array_new_with_free_func((GDestroyNotify) storage_snapshot_call_free);
+
+    GSequenceIter *iter = g_sequence_get_iter_at_pos(storage->calls_displayed, (gint) offset);
+    for (; !g_sequence_iter_is_end(iter) && g_ptr_array_len(snapshot->calls) < count;
+           iter = g_sequence_iter_next(iter)) {
+        Call *call = g_sequence_get(iter);
+        Message *msg = g_ptr_array_first(call->msgs);
+
+        StorageSnapshotCall *scall = g_malloc0(sizeof(StorageSnapshotCall));
+        scall->call = call;
+        scall->values = g_ptr_array_new_full(g_ptr_array_len(attributes), g_free);
+        for (guint i = 0; i < g_ptr_array_len(attributes); i++) {
+            g_ptr_array_add(scall->values,
+                            g_strdup(msg_get_attribute(msg, g_ptr_array_index(attributes, i))));
+        }
+        g_ptr_array_add(snapshot->calls, scall);
+    }
+
+    return snapshot;
+}
+
+void
+storage_snapshot_free(StorageSnapshot *snapshot)
+{
+    g_return_if_fail(snapshot != NULL);
+    g_ptr_array_free(snapshot->calls, TRUE);
+    g_free(snapshot);
+}
+
+void
+storage_calls_refilter()
+{
+    g_sequence_remove_range(
+        g_sequence_get_begin_iter(storage->calls_displayed),
+        g_sequence_get_end_iter(storage->calls_displayed)
+    );
+
+    GPtrArray *candidates = storage_calls_index_candidates();
+    if (candidates != NULL) {
+        // Calls not found in indexes can not match filters
+        GSequenceIter *iter = g_sequence_get_begin_iter(storage->calls_sorted);
+        for (; !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+            Call *call = g_sequence_get(iter);
+            // Filters are checked again if the call receives new messages
+            call->filtered = FILTER_CALL_UNCHECKED;
+            call->display_iter = NULL;
+        }
+
+        // Check all filters only in candidate calls
+        for (guint i = 0; i < g_ptr_array_len(candidates); i++) {
+            Call *call = g_ptr_array_index(candidates, i);
+            filter_reset_call(call);
+            if (filter_check_call(call, NULL)) {
+                call->display_iter = g_sequence_insert_sorted(
+                    storage->calls_displayed, call, storage_call_sorter, NULL
+                );
+            }
+        }
+
+        g_ptr_array_free(candidates, TRUE);
+        return;
+    }
+
+    // Sorted calls are appended keeping their order
+    GSequenceIter *iter = g_sequence_get_begin_iter(storage->calls_sorted);
+    for (; !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        Call *call = g_sequence_get(iter);
+        filter_reset_call(call);
+        call->display_iter = (filter_check_call(call, NULL))
+                             ? g_sequence_append(storage->calls_displayed, call)
+                             : NULL;
+    }
+}
+
+Call *
+storage_calls_find_time(guint64 ts, gboolean displayed)
+{
+    // Calls have index greater than zero, so this is sorted before any call started at ts
+    Call key = { .start_time = ts, .index = 0 };
+
+    GSequenceIter *iter = g_sequence_search(storage->calls_time, &key, storage_call_time_sorter, NULL);
+    for (; !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        Call *call = g_sequence_get(iter);
+        if (!displayed || call->display_iter != NULL)
+            return call;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Reorder calls list following the sorted calls sequence
+ *
+ * Removed calls must be purged before calling this function.
+ */
+static void
+storage_calls_sort_apply()
+{
+    if (!storage->sort_changed)
+        return;
+
+    guint i = 0;
+    GSequenceIter *iter = g_sequence_get_begin_iter(storage->calls_sorted);
+    for (; !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        storage->calls->pdata[i++] = g_sequence_get(iter);
+    }
+
+    storage->sort_changed = FALSE;
+}
+
+/**
+ * @brief Publish a new version of stored calls
+ *
+ * Interface checks the published version to know if stored calls have
+ * changed since the last time it was displayed.
+ */
+static void
+storage_calls_publish()
+{
+    g_atomic_int_inc(&storage->version);
+}
+
 gboolean
 storage_calls_changed()
 {
-    gboolean changed = storage->changed;
-    storage->changed = FALSE;
+    gint version = g_atomic_int_get(&storage->version);
+    gboolean changed = version != storage->version_seen;
+    storage->version_seen = version;
     return changed;
 }
 
+/**
+ * @brief Purge removed calls from calls list
+ *
+ * Removed calls are kept in the calls list until this function is called
+ * so removing the oldest calls does not require moving the whole list
+ * for each removal. Remaining calls keep their relative order.
+ */
+static void
+storage_calls_purge()
+{
+    if (storage->calls_removed == 0)
+        return;
+
+    guint len = 0;
+    for (guint i = 0; i < g_ptr_array_len(storage->calls); i++) {
+        Call *call = g_ptr_array_index(storage->calls, i);
+        if (call->removed) {
+            call_destroy(call);
+        } else {
+            storage->calls->pdata[len++] = call;
+        }
+    }
+
+    // Shrink the list without freeing the moved calls
+    g_ptr_array_set_free_func(storage->calls, NULL);
+    g_ptr_array_set_size(storage->calls, len);
+    g_ptr_array_set_free_func(storage->calls, call_destroy);
+
+    storage->calls_removed = 0;
+
+    // Removed calls may have released enough memory for a new payload index
+    if (storage->payload_index == NULL) {
+        storage_payload_index_reset();
+    }
+}
+
 guint
 storage_calls_count()
 {
-    return g_ptr_array_len(storage->calls);
+    return g_ptr_array_len(storage->calls) - storage->calls_removed;
 }
 
 gboolean
 storage_limit_reached()
 {
-    return g_ptr_array_len(storage->calls) >= storage->options.capture.limit;
+    return storage_calls_count() >= storage->options.capture.limit;
 }
 
 GPtrArray *
 storage_calls()
 {
+    storage_calls_purge();
+    storage_calls_sort_apply();
     return storage->calls;
 }
 
 StorageStats
 storage_calls_stats()
 {
-    StorageStats stats = { 0 };
+    StorageStats stats = storage->stats;
 
     // Total number of calls without filtering
-    stats.total = g_ptr_array_len(storage->calls);
+    stats.total = storage_calls_count();
 
     // Total number of calls after filtering
-    for (guint i = 0; i < g_ptr_array_len(storage->calls); i++) {
-        Call *call = g_ptr_array_index(storage->calls, i);
-        if (call->filtered != 1)
-            stats.displayed++;
-    }
+    stats.displayed = (guint) g_sequence_get_length(storage->calls_displayed);
 
     return stats;
 }
 
+/**
+ * @brief Update messages counters with an added or removed message
+ *
+ * @param msg Stored message
+ * @param count 1 for added messages, -1 for removed ones
+ */
+static void
+storage_stats_message(Message *msg, gint count)
+{
+    guint method = msg_get_method(msg);
+
+    storage->stats.msgs += count;
+
+    if (method < STORAGE_STATS_METHODS) {
+        storage->stats.methods[method] += count;
+    } else if (method / 100 < STORAGE_STATS_RESPONSES) {
+        storage->stats.responses[method / 100] += count;
+    }
+}
+
+/**
+ * @brief Update dialogs counters with an added or removed call
+ *
+ * @param call Stored call
+ * @param count 1 for added calls, -1 for removed ones
+ */
+static void
+storage_stats_call(Call *call, gint count)
+{
+    storage->stats.states[call->state] += count;
+
+    for (guint i = 0; i < call_msg_count(call); i++) {
+        storage_stats_message(g_ptr_array_index(call->msgs, i), count);
+    }
+}
+
+/**
+ * @brief Remove a Call-ID from the admitted Call-IDs table
+ *
+ * @param callid Call-ID to remove
+ */
+static void
+storage_callids_remove(const gchar *callid)
+{
+    g_mutex_lock(&storage->callids_lock);
+    g_hash_table_remove(storage->callids, callid);
+    g_mutex_unlock(&storage->callids_lock);
+}
+
+/**
+ * @brief Remember a Call-ID whose dialog will never be stored
+ *
+ * Rejected Call-IDs are kept in a bounded FIFO cache, discarding the oldest
+ * entries once MAX_REJECTED_CALLIDS has been reached.
+ * Caller must hold the Call-IDs tables lock.
+ *
+ * @param callid Call-ID to reject
+ */
+static void
+storage_callids_reject(const gchar *callid)
+{
+    if (g_hash_table_contains(storage->rejected, callid))
+        return;
+
+    // Discard oldest rejected Call-Id
+    if (g_queue_get_length(storage->rejected_order) >= MAX_REJECTED_CALLIDS) {
+        g_hash_table_remove(storage->rejected, g_queue_pop_head(storage->rejected_order));
+    }
+
+    const gchar *key = intern_ref(callid);
+    g_hash_table_add(storage->rejected, (gpointer) key);
+    g_queue_push_tail(storage->rejected_order, (gpointer) key);
+}
+
 void
 storage_calls_clear()
 {
     // Create again the callid hash table
+    g_mutex_lock(&storage->callids_lock);
     g_hash_table_remove_all(storage->callids);
+    g_mutex_unlock(&storage->callids_lock);
     g_hash_table_remove_all(storage->streams);
     g_hash_table_remove_all(storage->mrcp_channels);
+    g_sequence_remove_range(
+        g_sequence_get_begin_iter(storage->calls_displayed),
+        g_sequence_get_end_iter(storage->calls_displayed)
+    );
+    g_sequence_remove_range(
+        g_sequence_get_begin_iter(storage->calls_sorted),
+        g_sequence_get_end_iter(storage->calls_sorted)
+    );
+    storage->sort_changed = FALSE;
+    g_sequence_remove_range(
+        g_sequence_get_begin_iter(storage->calls_time),
+        g_sequence_get_end_iter(storage->calls_time)
+    );
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        g_hash_table_remove_all(storage->indexes[i]);
+    }
+    if (storage->calls_index != NULL) {
+        g_hash_table_remove_all(storage->calls_index);
+    }
+
+    // Remove all items from vector
+    g_ptr_array_remove_all(storage->calls);
+    g_queue_init(&storage->calls_order);
+    g_queue_init(&storage->calls_idle);
+    storage->calls_removed = 0;
+
+    // Reset all counters
+    memset(&storage->stats, 0, sizeof(StorageStats));
+
+    // Restart payload index, even if it was disabled
+    storage_payload_index_reset();
+}
+
+/**
+ * @brief Store current literal run if it is the longest found
+ *
+ * @param best Longest literal text found
+ * @param run Current literal text, emptied after this call
+ */
+static void
+storage_match_literal_commit(GString *best, GString *run)
+{
+    if (run->len > best->len) {
+        g_string_assign(best, run->str);
+    }
+    g_string_truncate(run, 0);
+}
+
+gchar *
+storage_match_literal(const gchar *expr, gboolean icase, gboolean extended, gboolean *exact)
+{
+    g_autoptr(GString) best = g_string_new(NULL);
+    g_autoptr(GString) run = g_string_new(NULL);
+    *exact = TRUE;
+
+    for (const gchar *c = expr; *c != '\0'; c++) {
+        switch (*c) {
+            case '|':
+            case ')':
+                // Alternations or unbalanced groups
+                return NULL;
+            case '\\':
+                if (*(c + 1) == '\0')
+                    return NULL;
+                c++;
+                if (g_ascii_isalnum(*c)) {
+                    // Only argument-less character types and assertions
+                    if (strchr("dDwWsShHvVRbBAzZG", *c) == NULL)
+                        return NULL;
+                    storage_match_literal_commit(best, run);
+                    *exact = FALSE;
+                } else {
+                    // Escaped punctuation is a literal character
+                    g_string_append_c(run, *c);
+                }
+                break;
+            case '(':
+                // Inline options may change the case sensitivity
+                if (*(c + 1) == '?')
+                    return NULL;
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                // Skip the whole group
+                for (gint depth = 1; depth > 0; ) {
+                    c++;
+                    if (*c == '\0')
+                        return NULL;
+                    if (*c == '\\' && *(c + 1) != '\0') {
+                        c++;
+                    } else if (*c == '(') {
+                        depth++;
+                    } else if (*c == ')') {
+                        depth--;
+                    } else if (*c == '[' || *c == '|') {
+                        // Do not try to parse classes or alternations in groups
+                        return NULL;
+                    }
+                }
+                break;
+            case '[':
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                // Skip the character class, a leading ']' is a literal
+                c++;
+                if (*c == '^')
+                    c++;
+                if (*c == ']')
+                    c++;
+                for (; *c != ']'; c++) {
+                    if (*c == '\0')
+                        return NULL;
+                    if (*c == '\\' && *(c + 1) != '\0') {
+                        c++;
+                    } else if (*c == '[' && *(c + 1) == ':') {
+                        // POSIX named class
+                        const gchar *end = strstr(c, ":]");
+                        if (end == NULL)
+                            return NULL;
+                        c = end + 1;
+                    }
+                }
+                break;
+            case '.':
+            case '^':
+            case '$':
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                break;
+            case '?':
+            case '*':
+                // Previous character is optional
+                if (run->len > 0)
+                    g_string_truncate(run, run->len - 1);
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                break;
+            case '+':
+                // Previous character is required at least once
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                break;
+            case '{': {
+                // Only {n}, {n,} and {n,m} quantifiers are supported
+                gchar *end = NULL;
+                guint64 min = g_ascii_strtoull(c + 1, &end, 10);
+                if (end == c + 1)
+                    return NULL;
+                while (g_ascii_isdigit(*end) || *end == ',')
+                    end++;
+                if (*end != '}')
+                    return NULL;
+                if (min == 0 && run->len > 0)
+                    g_string_truncate(run, run->len - 1);
+                storage_match_literal_commit(best, run);
+                *exact = FALSE;
+                c = end;
+                break;
+            }
+            case '#':
+                if (extended) {
+                    // Extended mode comment until end of line
+                    while (*(c + 1) != '\0' && *(c + 1) != '\n')
+                        c++;
+                    break;
+                }
+                // fall through
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case '\f':
+            case '\v':
+                if (extended) {
+                    // Extended mode ignores whitespace
+                    break;
+                }
+                // fall through
+            default:
+                if (icase) {
+                    // Unicode case folding matches non-ASCII, 'k' and 's' with other characters
+                    gchar lower = g_ascii_tolower(*c);
+                    if (!g_ascii_isprint(lower) || lower == 'k' || lower == 's') {
+                        storage_match_literal_commit(best, run);
+                        *exact = FALSE;
+                        break;
+                    }
+                    g_string_append_c(run, lower);
+                } else {
+                    g_string_append_c(run, *c);
+                }
+                break;
+        }
+    }
+
+    storage_match_literal_commit(best, run);
+
+    if (best->len == 0)
+        return NULL;
+
+    return g_string_free(g_steal_pointer(&best), FALSE);
+}
+
+/**
+ * @brief Search a lowercase literal in a payload ignoring ASCII case
+ *
+ * @param payload Payload data
+ * @param len Payload data length
+ * @param literal Lowercase literal text
+ * @param literal_len Literal text length
+ * @return TRUE if literal has been found in payload
+ */
+static gboolean
+storage_match_find_caseless(const gchar *payload, gsize len, const gchar *literal, gsize literal_len)
+{
+    if (len < literal_len)
+        return FALSE;
+
+    const gchar *last = payload + len - literal_len;
+    for (const gchar *c = payload; c <= last; c++) {
+        if (g_ascii_tolower(*c) != literal[0])
+            continue;
+
+        gsize i = 1;
+        while (i < literal_len && g_ascii_tolower(c[i]) == literal[i])
+            i++;
+
+        if (i == literal_len)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static gboolean
+storage_check_match_expr(const gchar *payload, gsize len)
+{
+    StorageMatchOpts *match = &storage->options.match;
+    gboolean matched;
+
+    // Everything matches when there is no match
+    if (match->mexpr == NULL)
+        return 1;
+
+    if (match->mliteral != NULL) {
+        // Search the literal text required by the expression
+        if (match->micase) {
+            matched = storage_match_find_caseless(payload, len, match->mliteral, match->mliteral_len);
+        } else {
+            matched = memmem(payload, len, match->mliteral, match->mliteral_len) != NULL;
+        }
+
+        // Only check the expression on candidate payloads
+        if (matched && !match->mliteral_exact) {
+            matched = g_regex_match_full(match->mregex, payload, (gssize) len, 0, 0, NULL, NULL);
+        }
+    } else {
+        // Check if payload matches the given expresion
+        matched = g_regex_match_full(match->mregex, payload, (gssize) len, 0, 0, NULL, NULL);
+    }
+
+    if (matched) {
+        return 0 == match->minvert;
+    } else {
+        return 1 == match->minvert;
+    }
+}
+
+/**
+ * @brief Check if a SIP packet dialog can be stored
+ *
+ * Checks the first packet of a dialog against the dialog match options
+ * (INVITE only dialogs and complete dialogs). Dialogs not passing these
+ * checks will never be stored, whatever their following packets contain.
+ *
+ * @param packet Packet with SIP protocol data
+ * @return TRUE if a new call can be created for this dialog
+ */
+static gboolean
+storage_check_sip_dialog(Packet *packet)
+{
+    PacketSipData *sip_data = packet_sip_data(packet);
+
+    // User requested only INVITE starting dialogs
+    if (storage->options.match.invite && sip_data->code.id != SIP_METHOD_INVITE)
+        return FALSE;
+
+    // Only create a new call if the first msg is a request message in the initial transaction
+    if (storage->options.match.complete &&
+        !(packet_sip_is_request(packet) && packet_sip_initial_transaction(packet)))
+        return FALSE;
+
+    return TRUE;
+}
+
+/**
+ * @brief Check if a SIP packet payload matches the match expression
+ *
+ * @param packet Packet with SIP protocol data
+ * @return TRUE if a new call can be created for this packet
+ */
+static gboolean
+storage_check_sip_payload(Packet *packet)
+{
+    PacketSipData *sip_data = packet_sip_data(packet);
+
+    // Check if payload matches expression
+    gsize len = 0;
+    const gchar *payload = g_bytes_get_data(sip_data->payload, &len);
+    return storage_check_match_expr(payload, len);
+}
+
+StorageMatchOpts
+storage_match_options()
+{
+    return storage->options.match;
+}
+
+void
+storage_set_sort_options(StorageSortOpts sort)
+{
+    storage->options.sort = sort;
+
+    // Update all calls sort keys before sorting
+    for (GSequenceIter *iter = g_sequence_get_begin_iter(storage->calls_sorted);
+         !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        call_sort_key_update(g_sequence_get(iter), sort.by);
+    }
+
+    g_sequence_sort(storage->calls_sorted, storage_call_sorter, NULL);
+    g_sequence_sort(storage->calls_displayed, storage_call_sorter, NULL);
+    storage->sort_changed = TRUE;
+}
+
+StorageSortOpts
+storage_sort_options()
+{
+    return storage->options.sort;
+}
+
+StorageCaptureOpts
+storage_capture_options()
+{
+    return storage->options.capture;
+}
+
+gboolean
+storage_stream_key(StorageStreamKey *key, const gchar *dstip, guint16 dport)
+{
+    memset(key, 0, sizeof(StorageStreamKey));
+
+    if (dstip == NULL)
+        return FALSE;
+
+    if (inet_pton(AF_INET, dstip, key->addr) == 1) {
+        key->family = AF_INET;
+#ifdef USE_IPV6
+    } else if (inet_pton(AF_INET6, dstip, key->addr) == 1) {
+        key->family = AF_INET6;
+#endif
+    } else {
+        return FALSE;
+    }
+
+    key->port = dport;
+    return TRUE;
+}
+
+guint
+storage_stream_key_hash(gconstpointer key)
+{
+    const guint8 *data = key;
+
+    // FNV-1a hash of the packed key
+    guint32 hash = 2166136261U;
+    for (gsize i = 0; i < sizeof(StorageStreamKey); i++) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+gboolean
+storage_stream_key_equal(gconstpointer a, gconstpointer b)
+{
+    return memcmp(a, b, sizeof(StorageStreamKey)) == 0;
+}
+
+static void
+storage_register_stream(const StorageStreamKey *key, Message *msg)
+{
+    StorageStreamKey *hashkey = g_new(StorageStreamKey, 1);
+    *hashkey = *key;
+    g_hash_table_replace(storage->streams, hashkey, msg);
+}
+
+/**
+ * @brief Get the stream keys for a SDP media of a message
+ *
+ * Each media registers its RTP and RTCP streams and a RTP stream using
+ * the message source address as destination.
+ *
+ * @param msg SIP message structure
+ * @param media SDP media of the message
+ * @param keys Array where stream keys will be stored
+ * @return number of keys stored in the array
+ */
+static guint
+storage_media_stream_keys(Message *msg, PacketSdpMedia *media, StorageStreamKey keys[3])
+{
+    guint count = 0;
+
+    if (address_get_ip(media->address) == NULL)
+        return 0;
+
+    // Create RTP stream for this media
+    if (storage_stream_key(&keys[count],
+                           address_get_ip(media->address),
+                           address_get_port(media->address))) {
+        count++;
+    }
+
+    // Create RTCP stream for this media
+    if (storage_stream_key(&keys[count],
+                           address_get_ip(media->address),
+                           address_get_port(media->address) + 1)) {
+        count++;
+    }
+
+    // Create RTP stream with source of message as destination address
+    Address msg_src = msg_src_address(msg);
+    if (!address_equals(media->address, msg_src)) {
+        if (storage_stream_key(&keys[count],
+                               address_get_ip(msg_src),
+                               address_get_port(media->address))) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Parse SIP Message payload for SDP media streams
+ *
+ * Parse the payload content to get SDP information
+ *
+ * @param msg SIP message structure
+ * @return 0 in all cases
+ */
+static void
+storage_register_streams(Message *msg)
+{
+    Packet *packet = msg->packet;
+
+    PacketSdpData *sdp = packet_sdp_data(packet);
+    if (sdp == NULL) {
+        // Packet without SDP content
+        return;
+    }
+
+    for (guint i = 0; i < g_list_length(sdp->medias); i++) {
+        PacketSdpMedia *media = g_list_nth_data(sdp->medias, i);
+
+        StorageStreamKey keys[3];
+        guint count = storage_media_stream_keys(msg, media, keys);
+        for (guint j = 0; j < count; j++) {
+            storage_register_stream(&keys[j], msg);
+        }
+    }
+}
+
+static void
+storage_register_mrcp_channels(Message *msg)
+{
+    Packet *packet = msg->packet;
+
+    PacketSdpData *sdp = packet_sdp_data(packet);
+    if (sdp == NULL) {
+        // Packet without SDP content
+        return;
+    }
+
+    for (guint i = 0; i < g_list_length(sdp->medias); i++) {
+        PacketSdpMedia *media = g_list_nth_data(sdp->medias, i);
+
+        if (media->channel == NULL)
+            continue;
+
+        // Add this channel to hash table
+        g_hash_table_remove(storage->mrcp_channels, media->channel);
+        g_hash_table_insert(storage->mrcp_channels, g_strdup(media->channel), msg_get_call(msg));
+    }
+}
+
+/**
+ * @brief Remove all stream and MRCP channel entries registered by a call
+ *
+ * Entries registered again by a newer call are kept.
+ *
+ * @param call Call being removed from storage
+ */
+static void
+storage_unregister_call_media(Call *call)
+{
+    for (guint i = 0; i < call_msg_count(call); i++) {
+        Message *msg = g_ptr_array_index(call->msgs, i);
+
+        PacketSdpData *sdp = packet_sdp_data(msg->packet);
+        if (sdp == NULL)
+            continue;
+
+        for (GList *l = sdp->medias; l != NULL; l = l->next) {
+            PacketSdpMedia *media = l->data;
+
+            StorageStreamKey keys[3];
+            guint count = storage_media_stream_keys(msg, media, keys);
+            for (guint j = 0; j < count; j++) {
+                Message *stream_msg = g_hash_table_lookup(storage->streams, &keys[j]);
+                if (stream_msg != NULL && msg_get_call(stream_msg) == call) {
+                    g_hash_table_remove(storage->streams, &keys[j]);
+                }
+            }
+
+            if (media->channel != NULL
+                && g_hash_table_lookup(storage->mrcp_channels, media->channel) == call) {
+                g_hash_table_remove(storage->mrcp_channels, media->channel);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Remove a call from all storage indexes
+ *
+ * The call is flagged as removed and will be freed the next time the
+ * calls list is purged.
+ *
+ * @param call Call to be removed
+ */
+static void
+storage_call_remove(Call *call)
+{
+    // Remove from parent call X-Call-Id list
+    if (call->xcallid != NULL) {
+        g_mutex_lock(&storage->callids_lock);
+        Call *xcall = g_hash_table_lookup(storage->callids, call->xcallid);
+        g_mutex_unlock(&storage->callids_lock);
+        if (xcall != NULL) {
+            g_ptr_array_remove(xcall->xcalls, call);
+        }
+    }
+
+    // Remove call and its messages from counters
+    storage_stats_call(call, -1);
+
+    // Remove from Call-Id hash table
+    storage_callids_remove(call->callid);
+    // Remove from streams and MRCP channels hash tables
+    storage_unregister_call_media(call);
+    // Remove from insertion order list
+    g_queue_unlink(&storage->calls_order, &call->order_link);
+    // Remove from secondary indexes
+    storage_calls_index_remove(call);
+    // Remove from sorted and displayed calls sequences
+    g_sequence_remove(call->sort_iter);
+    call->sort_iter = NULL;
+    if (call->display_iter != NULL) {
+        g_sequence_remove(call->display_iter);
+        call->display_iter = NULL;
+    }
+    storage->sort_changed = TRUE;
+    // Remove from activity order list
+    if (!call->cold) {
+        g_queue_unlink(&storage->calls_idle, &call->idle_link);
+    }
 
-    // Remove all items from vector
-    g_ptr_array_remove_all(storage->calls);
+    // Mark as pending to be removed from calls list
+    call->removed = TRUE;
+    storage->calls_removed++;
 }
 
 void
@@ -142,165 +1327,220 @@ storage_calls_clear_soft()
         Call *call = g_ptr_array_index(storage->calls, i);
 
         // Filtered call, remove from all lists
-        if (filter_check_call(call, NULL)) {
-            // Remove from Call-Id hash table
-            g_hash_table_remove(storage->callids, call->callid);
-            // Remove from calls list
-            g_ptr_array_remove(storage->calls, call);
+        if (!call->removed && filter_check_call(call, NULL)) {
+            storage_call_remove(call);
         }
     }
+
+    storage_calls_purge();
 }
 
 static void
 storage_calls_rotate()
 {
-    for (guint i = 0; i < g_ptr_array_len(storage->calls); i++) {
-        Call *call = g_ptr_array_index(storage->calls, i);
+    // Find the oldest call that is not locked
+    for (GList *l = storage->calls_order.head; l != NULL; l = l->next) {
+        Call *call = l->data;
 
         if (!call->locked) {
-            // Remove from callids hash
-            g_hash_table_remove(storage->callids, call->callid);
-            // Remove first call from active and call lists
-            g_ptr_array_remove(storage->calls, call);
-            return;
+            storage_call_remove(call);
+            break;
         }
     }
+
+    // Purge removed calls once they are a significant part of the list
+    if (storage->calls_removed * 4 >= g_ptr_array_len(storage->calls)) {
+        storage_calls_purge();
+    }
 }
 
+/**
+ * @brief Release protocol payloads pointing into packet frames contents
+ *
+ * Released payloads are loaded back from frames contents when required.
+ *
+ * @param packet Stored packet
+ * @return TRUE if frames contents are no longer referenced by any payload
+ */
 static gboolean
-storage_check_match_expr(const char *payload)
+storage_packet_release_payloads(Packet *packet)
 {
-    // Everything matches when there is no match
-    if (storage->options.match.mexpr == NULL)
-        return 1;
+    gboolean released = TRUE;
 
-    // Check if payload matches the given expresion
-    if (g_regex_match(storage->options.match.mregex, payload, 0, NULL)) {
-        return 0 == storage->options.match.minvert;
-    } else {
-        return 1 == storage->options.match.minvert;
+    if (packet_has_protocol(packet, PACKET_PROTO_SIP)) {
+        released = packet_sip_payload_release(packet) && released;
     }
 
-}
+    if (packet_has_protocol(packet, PACKET_PROTO_RTP)) {
+        released = packet_rtp_payload_release(packet) && released;
+    }
 
-StorageMatchOpts
-storage_match_options()
-{
-    return storage->options.match;
-}
+    if (packet_has_protocol(packet, PACKET_PROTO_MRCP)) {
+        released = packet_mrcp_payload_release(packet) && released;
+    }
 
-void
-storage_set_sort_options(StorageSortOpts sort)
-{
-    storage->options.sort = sort;
-    g_ptr_array_sort(storage->calls, (GCompareFunc) storage_call_attr_sorter);
+    return released;
 }
 
-StorageSortOpts
-storage_sort_options()
+/**
+ * @brief Get all packet frames of a call messages
+ *
+ * @param call Call with messages
+ * @return array of frames (PacketFrame *) to be freed by caller
+ */
+static GPtrArray *
+storage_call_frames(Call *call)
 {
-    return storage->options.sort;
-}
+    GPtrArray *frames = g_ptr_array_new();
 
-StorageCaptureOpts
-storage_capture_options()
-{
-    return storage->options.capture;
+    for (guint i = 0; i < call_msg_count(call); i++) {
+        Message *msg = g_ptr_array_index(call->msgs, i);
+        for (GList *l = msg->packet->frames; l != NULL; l = l->next) {
+            g_ptr_array_add(frames, l->data);
+        }
+    }
+
+    return frames;
 }
 
-static gchar *
-storage_stream_key(const gchar *dstip, guint16 dport)
+/**
+ * @brief Move a call to cold storage
+ *
+ * Call messages frames are compressed and stored RTP packets are
+ * discarded, keeping only streams information and statistics.
+ *
+ * @param call Call without recent activity
+ */
+static void
+storage_call_freeze(Call *call)
 {
-    return g_strdup_printf(
-        "%s:%u",
-        (dstip) ? dstip : "", dport
-    );
+    // Frames still referenced by protocol payloads are kept in memory
+    g_autoptr(GPtrArray) frames = g_ptr_array_new();
+    for (guint i = 0; i < call_msg_count(call); i++) {
+        Message *msg = g_ptr_array_index(call->msgs, i);
+        if (!storage_packet_release_payloads(msg->packet))
+            continue;
+        for (GList *l = msg->packet->frames; l != NULL; l = l->next) {
+            g_ptr_array_add(frames, l->data);
+        }
+    }
+
+    // Compress messages frames, failed ones are kept in memory
+    storage_cold_compress_frames(frames, NULL);
+
+    // Discard stored RTP packets
+    for (guint i = 0; i < g_ptr_array_len(call->streams); i++) {
+        Stream *stream = g_ptr_array_index(call->streams, i);
+        g_ptr_array_remove_all(stream->packets);
+    }
+
+    // Cold calls are no longer aged
+    g_queue_unlink(&storage->calls_idle, &call->idle_link);
+    call->cold = TRUE;
 }
 
-static void
-storage_register_stream(gchar *hashkey, Message *msg)
+void
+storage_call_thaw(Call *call)
 {
-    g_hash_table_remove(storage->streams, hashkey);
-    g_hash_table_insert(storage->streams, hashkey, msg);
+    g_return_if_fail(call != NULL);
+
+    // Interface threads can also restore calls
+    storage_lock();
+
+    if (!call->cold || call->removed) {
+        storage_unlock();
+        return;
+    }
+
+    // Decompress messages frames
+    g_autoptr(GPtrArray) frames = storage_call_frames(call);
+    storage_cold_decompress_frames(frames);
+
+    // Start aging the call again
+    call->cold = FALSE;
+    call->updated = g_get_monotonic_time();
+    g_queue_push_tail_link(&storage->calls_idle, &call->idle_link);
+
+    storage_unlock();
 }
 
 /**
- * @brief Parse SIP Message payload for SDP media streams
+ * @brief Register new activity for a stored call
  *
- * Parse the payload content to get SDP information
+ * Cold calls are restored back to memory before adding new packets.
  *
- * @param msg SIP message structure
- * @return 0 in all cases
+ * @param call Call receiving a new packet
  */
 static void
-storage_register_streams(Message *msg)
+storage_call_touch(Call *call)
 {
-    Packet *packet = msg->packet;
-
-    PacketSdpData *sdp = packet_sdp_data(packet);
-    if (sdp == NULL) {
-        // Packet without SDP content
+    if (call->cold) {
+        storage_call_thaw(call);
         return;
     }
 
-    for (guint i = 0; i < g_list_length(sdp->medias); i++) {
-        PacketSdpMedia *media = g_list_nth_data(sdp->medias, i);
+    // Move the call to the end of activity order list
+    call->updated = g_get_monotonic_time();
+    g_queue_unlink(&storage->calls_idle, &call->idle_link);
+    g_queue_push_tail_link(&storage->calls_idle, &call->idle_link);
+}
 
-        if (address_get_ip(media->address) == NULL)
-            continue;
+/**
+ * @brief Move calls without recent activity to cold storage
+ *
+ * Calls being displayed (locked) are always kept in memory.
+ */
+static gboolean
+storage_calls_age()
+{
+    gint64 limit = g_get_monotonic_time() - (gint64) storage->options.capture.cold_age * G_USEC_PER_SEC;
 
-        // Create RTP stream for this media
-        storage_register_stream(
-            storage_stream_key(
-                address_get_ip(media->address),
-                address_get_port(media->address)
-            ),
-            msg
-        );
+    storage_lock();
 
-        // Create RTCP stream for this media
-        storage_register_stream(
-            storage_stream_key(
-                address_get_ip(media->address),
-                address_get_port(media->address) + 1
-            ),
-            msg
-        );
+    GList *l = storage->calls_idle.head;
+    while (l != NULL) {
+        Call *call = l->data;
 
-        // Create RTP stream with source of message as destination address
-        Address msg_src = msg_src_address(msg);
-        if (!address_equals(media->address, msg_src)) {
-            storage_register_stream(
-                storage_stream_key(
-                    address_get_ip(msg_src),
-                    address_get_port(media->address)
-                ),
-                msg
-            );
+        // Remaining calls have had activity after this one
+        if (call->updated > limit)
+            break;
+
+        l = l->next;
+
+        if (!call->locked) {
+            storage_call_freeze(call);
         }
     }
+
+    storage_unlock();
+    return TRUE;
 }
 
+/**
+ * @brief Move stored packet frames contents to disk
+ *
+ * This only applies when disk storage mode is enabled. If any frame can not
+ * be written, it will be kept in memory.
+ *
+ * @param packet Packet that has been added to storage
+ */
 static void
-storage_register_mrcp_channels(Message *msg)
+storage_packet_to_disk(Packet *packet)
 {
-    Packet *packet = msg->packet;
-
-    PacketSdpData *sdp = packet_sdp_data(packet);
-    if (sdp == NULL) {
-        // Packet without SDP content
+    if (storage->options.capture.mode != STORAGE_MODE_DISK)
         return;
-    }
 
-    for (guint i = 0; i < g_list_length(sdp->medias); i++) {
-        PacketSdpMedia *media = g_list_nth_data(sdp->medias, i);
+    // Frames still referenced by protocol payloads would not release any memory
+    if (!storage_packet_release_payloads(packet))
+        return;
 
-        if (media->channel == NULL)
+    for (GList *l = packet->frames; l != NULL; l = l->next) {
+        PacketFrame *frame = l->data;
+        if (frame->data == NULL)
             continue;
 
-        // Add this channel to hash table
-        g_hash_table_remove(storage->streams, media->channel);
-        g_hash_table_insert(storage->mrcp_channels, g_strdup(media->channel), msg_get_call(msg));
+        if (!storage_disk_store_frame(frame, NULL))
+            return;
     }
 }
 
@@ -313,37 +1553,47 @@ storage_check_sip_packet(Packet *packet)
     PacketSipData *sip_data = packet_sip_data(packet);
 
     // Find the call for this msg
-    if (!(call = g_hash_table_lookup(storage->callids, sip_data->callid))) {
-
-        // Check if payload matches expression
-        g_autofree const gchar *payload = packet_sip_payload_str(packet);
-        if (!storage_check_match_expr(payload))
-            return;
-
-        // User requested only INVITE starting dialogs
-        if (storage->options.match.invite && sip_data->code.id != SIP_METHOD_INVITE)
-            return;
+    g_mutex_lock(&storage->callids_lock);
+    gboolean admitted = g_hash_table_lookup_extended(storage->callids, sip_data->callid, NULL, (gpointer *) &call);
+    g_mutex_unlock(&storage->callids_lock);
+
+    if (call == NULL) {
+
+        // Dialogs not admitted by the SIP dissector must be checked here
+        if (!admitted) {
+            if (!storage_check_sip_dialog(packet)) {
+                g_mutex_lock(&storage->callids_lock);
+                storage_callids_reject(sip_data->callid);
+                g_mutex_unlock(&storage->callids_lock);
+                return;
+            }
 
-        // Only create a new call if the first msg is a request message in the initial transaction
-        if (storage->options.match.complete &&
-            !(packet_sip_is_request(packet) && packet_sip_initial_transaction(packet)))
-            return;
+            // Following packets of this dialog may still match the expression
+            if (!storage_check_sip_payload(packet))
+                return;
+        }
 
         // Rotate call list if limit has been reached
         if (storage->options.capture.limit == storage_calls_count()) {
             if (storage->options.capture.rotate) {
                 storage_calls_rotate();
             } else {
+                // Release dialog reservation, it will be checked again
+                storage_callids_remove(sip_data->callid);
                 return;
             }
         }
 
         // Create the call if not found
-        if ((call = call_create(sip_data->callid, sip_data->xcallid)) == NULL)
+        if ((call = call_create(sip_data->callid, sip_data->xcallid)) == NULL) {
+            storage_callids_remove(sip_data->callid);
             return;
+        }
 
         // Add this Call-Id to hash table
-        g_hash_table_insert(storage->callids, g_strdup(call->callid), call);
+        g_mutex_lock(&storage->callids_lock);
+        g_hash_table_insert(storage->callids, (gpointer) intern_ref(call->callid), call);
+        g_mutex_unlock(&storage->callids_lock);
 
         // Set call index
         call->index = ++storage->last_index;
@@ -352,19 +1602,31 @@ storage_check_sip_packet(Packet *packet)
         newcall = TRUE;
     }
 
+    // Restore cold calls before adding new messages
+    if (!newcall) {
+        storage_call_touch(call);
+    }
+
     // At this point we know we're handling an interesting SIP Packet
-    Message *msg = msg_new(packet);
+    Message *msg = msg_new(call, packet);
 
     // Always dissect first call message
     if (call_msg_count(call) == 0) {
         // If this call has X-Call-Id, append it to the parent call
         if (call->xcallid) {
-            call_add_xcall(g_hash_table_lookup(storage->callids, call->xcallid), call);
+            g_mutex_lock(&storage->callids_lock);
+            Call *xcall = g_hash_table_lookup(storage->callids, call->xcallid);
+            g_mutex_unlock(&storage->callids_lock);
+            call_add_xcall(xcall, call);
         }
     }
 
     // Add the message to the call
     call_add_message(call, msg);
+    // Calculate regular expression attributes in a single payload scan
+    attribute_regex_scan(msg);
+    // Index message payload for payload filters
+    storage_payload_index_add(msg);
 
     // Parse media data
     storage_register_streams(msg);
@@ -373,19 +1635,95 @@ storage_check_sip_packet(Packet *packet)
 
     if (call_is_invite(call)) {
         // Update Call State
+        enum CallState state = call->state;
         call_update_state(call, msg);
+
+        // Update call state counters of already stored calls
+        if (!newcall && state != call->state) {
+            storage->stats.states[state]--;
+            storage->stats.states[call->state]++;
+        }
     }
 
     if (newcall) {
+        // Add this call and its first message to counters
+        storage_stats_call(call, 1);
+        // Add this call to secondary indexes
+        storage_calls_index_insert(call);
+        // Insert this call in the sorted calls sequence
+        storage_calls_sort_insert(call);
+        // Insert this call in displayed calls if matches filters
+        storage_calls_display_update(call, msg);
         // Append this call to the call list
         g_ptr_array_add(storage->calls, call);
+        // Append this call to the insertion order list
+        call->order_link.data = call;
+        g_queue_push_tail_link(&storage->calls_order, &call->order_link);
+        // Append this call to the activity order list
+        call->updated = g_get_monotonic_time();
+        call->idle_link.data = call;
+        g_queue_push_tail_link(&storage->calls_idle, &call->idle_link);
+    } else {
+        // Add this message to counters
+        storage_stats_message(msg, 1);
+        // Update this call position in the sorted calls sequence
+        storage_calls_sort_update(call);
+        // Check again if this call matches filters
+        storage_calls_display_update(call, msg);
     }
 
-    // Mark the list as changed
-    storage->changed = TRUE;
+    // Publish the list changes
+    storage_calls_publish();
 
     // Send this packet to all capture outputs
     capture_manager_output_packet(capture_manager_get_instance(), packet);
+
+    // Move packet contents to disk if requested
+    storage_packet_to_disk(packet);
+}
+
+gboolean
+storage_check_sip_admission(Packet *packet)
+{
+    PacketSipData *sip_data = packet_sip_data(packet);
+    g_return_val_if_fail(sip_data != NULL, FALSE);
+    g_return_val_if_fail(sip_data->callid != NULL, FALSE);
+
+    // Nothing to check without storage
+    if (storage == NULL)
+        return TRUE;
+
+    g_mutex_lock(&storage->callids_lock);
+    // Packet from an already admitted dialog
+    if (g_hash_table_contains(storage->callids, sip_data->callid)) {
+        g_mutex_unlock(&storage->callids_lock);
+        return TRUE;
+    }
+    // Packet from an already rejected dialog
+    if (g_hash_table_contains(storage->rejected, sip_data->callid)) {
+        g_mutex_unlock(&storage->callids_lock);
+        return FALSE;
+    }
+    g_mutex_unlock(&storage->callids_lock);
+
+    // First packet of this dialog, check if it can be stored
+    gboolean allowed = storage_check_sip_dialog(packet);
+    gboolean admitted = allowed && storage_check_sip_payload(packet);
+
+    g_mutex_lock(&storage->callids_lock);
+    if (admitted) {
+        // Reserve this Call-Id until storage creates its call
+        if (!g_hash_table_contains(storage->callids, sip_data->callid)) {
+            g_hash_table_insert(storage->callids, (gpointer) intern_ref(sip_data->callid), NULL);
+        }
+    } else if (!allowed) {
+        // Only remember dialogs that will never be stored, expression
+        // misses are checked again with the following dialog packets
+        storage_callids_reject(sip_data->callid);
+    }
+    g_mutex_unlock(&storage->callids_lock);
+
+    return admitted;
 }
 
 void
@@ -399,8 +1737,10 @@ storage_check_rtp_packet(Packet *packet)
     Address dst = packet_dst_address(packet);
 
     // Find the stream by destination
-    g_autofree gchar *hashkey = storage_stream_key(address_get_ip(dst), address_get_port(dst));
-    Message *msg = g_hash_table_lookup(storage->streams, hashkey);
+    StorageStreamKey hashkey;
+    if (!storage_stream_key(&hashkey, address_get_ip(dst), address_get_port(dst)))
+        return;
+    Message *msg = g_hash_table_lookup(storage->streams, &hashkey);
 
     // No call has setup this stream
     if (msg == NULL)
@@ -408,6 +1748,7 @@ storage_check_rtp_packet(Packet *packet)
 
     // Mark call as changed
     Call *call = msg_get_call(msg);
+    storage_call_touch(call);
 
     // Find a matching stream in the call
     Stream *stream = call_find_stream(call, src, dst, rtp->ssrc);
@@ -425,14 +1766,20 @@ storage_check_rtp_packet(Packet *packet)
     stream_add_packet(stream, packet);
 
     // Store packet if rtp capture is enabled
-    if (storage->options.capture.rtp || packet_has_protocol(packet, PACKET_PROTO_TELEVT)) {
+    gboolean stored = storage->options.capture.rtp || packet_has_protocol(packet, PACKET_PROTO_TELEVT);
+    if (stored) {
         g_ptr_array_add(stream->packets, packet_ref(packet));
     }
 
-    // Mark the list as changed
-    storage->changed = TRUE;
+    // Publish the list changes
+    storage_calls_publish();
 
     capture_manager_output_packet(capture_manager_get_instance(), packet);
+
+    // Move packet contents to disk if requested
+    if (stored) {
+        storage_packet_to_disk(packet);
+    }
 }
 
 void
@@ -446,8 +1793,10 @@ storage_check_rtcp_packet(Packet *packet)
     Address dst = packet_dst_address(packet);
 
     // Find the stream by destination
-    g_autofree gchar *hashkey = storage_stream_key(address_get_ip(dst), address_get_port(dst));
-    Message *msg = g_hash_table_lookup(storage->streams, hashkey);
+    StorageStreamKey hashkey;
+    if (!storage_stream_key(&hashkey, address_get_ip(dst), address_get_port(dst)))
+        return;
+    Message *msg = g_hash_table_lookup(storage->streams, &hashkey);
 
     // No call has setup this stream
     if (msg == NULL)
@@ -455,6 +1804,7 @@ storage_check_rtcp_packet(Packet *packet)
 
     // Mark call as changed
     Call *call = msg_get_call(msg);
+    storage_call_touch(call);
 
     // Find a matching stream in the call
     Stream *stream = call_find_stream(call, src, dst, 0);
@@ -474,10 +1824,15 @@ storage_check_rtcp_packet(Packet *packet)
         g_ptr_array_add(stream->packets, packet_ref(packet));
     }
 
-    // Mark the list as changed
-    storage->changed = TRUE;
+    // Publish the list changes
+    storage_calls_publish();
 
     capture_manager_output_packet(capture_manager_get_instance(), packet);
+
+    // Move packet contents to disk if requested
+    if (storage->options.capture.rtp) {
+        storage_packet_to_disk(packet);
+    }
 }
 
 static void
@@ -490,22 +1845,37 @@ storage_check_mrcp_packet(Packet *packet)
     if (call == NULL)
         return;
 
+    // Restore cold calls before adding new messages
+    storage_call_touch(call);
+
     // Create a new call message for this MRCP
-    Message *msg = msg_new(packet);
+    Message *msg = msg_new(call, packet);
 
     // Add the message to the call
     call_add_message(call, msg);
+    // Calculate regular expression attributes in a single payload scan
+    attribute_regex_scan(msg);
+    // Index message payload for payload filters
+    storage_payload_index_add(msg);
+    storage_stats_message(msg, 1);
+    storage_calls_sort_update(call);
+    storage_calls_display_update(call, msg);
 
-    // Mark the list as changed
-    storage->changed = TRUE;
+    // Publish the list changes
+    storage_calls_publish();
 
     // Send this packet to all capture outputs
     capture_manager_output_packet(capture_manager_get_instance(), packet);
+
+    // Move packet contents to disk if requested
+    storage_packet_to_disk(packet);
 }
 
 static gboolean
 storage_check_packet(Packet *packet, G_GNUC_UNUSED gpointer user_data)
 {
+    storage_lock();
+
     if (packet_has_protocol(packet, PACKET_PROTO_SIP)) {
         storage_check_sip_packet(packet);
     } else if (packet_has_protocol(packet, PACKET_PROTO_RTP)) {
@@ -521,27 +1891,70 @@ storage_check_packet(Packet *packet, G_GNUC_UNUSED gpointer user_data)
         packet->frames = NULL;
     }
 
+    storage_unlock();
+
     packet_unref(packet);
+    g_atomic_int_add(&storage->pending, -1);
     return TRUE;
 }
 
 void
 storage_add_packet(Packet *packet)
 {
-    g_async_queue_push(storage->queue, (gpointer) packet_ref(packet));
+    g_atomic_int_inc(&storage->pending);
+
+    g_async_queue_lock(storage->queue);
+    g_async_queue_push_unlocked(storage->queue, (gpointer) packet_ref(packet));
+    gint length = g_async_queue_length_unlocked(storage->queue);
+    g_async_queue_unlock(storage->queue);
+
+    // Wake up storage thread if it was waiting for packets
+    if (length == 1) {
+        g_main_context_wakeup(g_main_loop_get_context(storage->loop));
+    }
 }
 
 gint
 storage_pending_packets()
 {
-    return g_async_queue_length(storage->queue);
+    return g_atomic_int_get(&storage->pending);
+}
+
+void
+storage_lock()
+{
+    g_rec_mutex_lock(&storage->lock);
+}
+
+void
+storage_unlock()
+{
+    g_rec_mutex_unlock(&storage->lock);
+}
+
+void
+storage_memory_account(StorageMemoryType type, gssize bytes)
+{
+    g_return_if_fail(type < STORAGE_MEMORY_COUNT);
+    g_atomic_pointer_add(&storage_memory[type], bytes);
+}
+
+gsize
+storage_memory_usage_by_type(StorageMemoryType type)
+{
+    g_return_val_if_fail(type < STORAGE_MEMORY_COUNT, 0);
+    gssize usage = (gssize) g_atomic_pointer_get(&storage_memory[type]);
+    return (usage > 0) ? (gsize) usage : 0;
 }
 
 gsize
 storage_memory_usage()
 {
-    struct mallinfo info = mallinfo();
-    return info.arena;
+    gsize usage = 0;
+    for (guint i = 0; i < STORAGE_MEMORY_COUNT; i++) {
+        usage += storage_memory_usage_by_type(i);
+    }
+    return usage;
 }
 
 gsize
@@ -550,6 +1963,87 @@ storage_memory_limit()
     return storage->options.capture.memory_limit;
 }
 
+gboolean
+storage_payload_index_disabled()
+{
+    return storage->options.capture.payload_index && storage->payload_index == NULL;
+}
+
+/**
+ * @brief Check if a call will not receive more messages
+ *
+ * Non INVITE dialogs are considered completed. INVITE dialogs are
+ * completed once they reach a final state.
+ */
+static gboolean
+storage_call_is_completed(Call *call)
+{
+    if (call_msg_count(call) == 0 || !call_is_invite(call))
+        return TRUE;
+
+    return call->state != CALL_STATE_CALLSETUP && call->state != CALL_STATE_INCALL;
+}
+
+/**
+ * @brief Remove oldest calls until memory usage is below the target
+ *
+ * @param target Memory usage to reach in bytes
+ * @param completed Only remove completed calls
+ */
+static void
+storage_memory_evict_calls(gsize target, gboolean completed)
+{
+    guint removed = 0;
+
+    GList *l = storage->calls_order.head;
+    while (l != NULL && storage_memory_usage() > target) {
+        Call *call = l->data;
+        l = l->next;
+
+        if (call->locked)
+            continue;
+
+        if (completed && !storage_call_is_completed(call))
+            continue;
+
+        storage_call_remove(call);
+
+        // Removed calls memory is released when calls list is purged
+        if (++removed % STORAGE_MEMORY_EVICT_BATCH == 0) {
+            storage_calls_purge();
+        }
+    }
+
+    storage_calls_purge();
+}
+
+/**
+ * @brief Remove stored RTP packets until memory usage is below the target
+ *
+ * Stream information and statistics are kept. Calls being displayed
+ * (locked) keep their RTP packets.
+ *
+ * @param target Memory usage to reach in bytes
+ */
+static void
+storage_memory_evict_rtp(gsize target)
+{
+    for (GList *l = storage->calls_order.head; l != NULL; l = l->next) {
+        Call *call = l->data;
+
+        if (call->locked)
+            continue;
+
+        for (guint i = 0; i < g_ptr_array_len(call->streams); i++) {
+            Stream *stream = g_ptr_array_index(call->streams, i);
+            g_ptr_array_remove_all(stream->packets);
+        }
+
+        if (storage_memory_usage() <= target)
+            return;
+    }
+}
+
 static gboolean
 storage_check_memory()
 {
@@ -559,53 +2053,92 @@ storage_check_memory()
     }
 
     // Check if memory has reached the limit
-    if (storage_memory_usage() >= storage_memory_limit()) {
+    if (storage_memory_usage() < storage_memory_limit()) {
+        return TRUE;
+    }
 
-        // Pause capture manager
-        capture_manager_set_pause(
-            capture_manager_get_instance(),
-            TRUE
-        );
+    storage_lock();
 
-        // Convert memory limit to a human readable format
-        g_autofree const gchar *limit = g_format_size_full(
-            storage_memory_limit(),
-            G_FORMAT_SIZE_IEC_UNITS
-        );
+    // Release some extra memory to avoid evicting on every check
+    gsize target = storage_memory_limit() / 10 * 9;
 
-        // TODO Replace this with a Signal
-        if (tui_is_enabled()) {
-            // Show a dialog with current configured memory limit
-            dialog_run(
-                "Memory limit %s has been reached. \n\n%s\n%s",
-                limit,
-                "Capture has been stopped.",
-                "See capture.mem_limit setting and -m flag for further info."
-            );
-        } else {
-            fprintf(
-                stderr,
-                "\rMemory limit %s has been reached. %s %s\n",
-                limit,
-                "Capture has been stopped.",
-                "See capture.mem_limit setting and -m flag for further info."
-            );
-        }
-        return FALSE;
+    // Remove oldest completed dialogs first
+    storage_memory_evict_calls(target, TRUE);
+
+    // Then remove stored RTP packets
+    if (storage_memory_usage() > target) {
+        storage_memory_evict_rtp(target);
     }
 
+    // Finally remove oldest dialogs, even if they are not completed
+    if (storage_memory_usage() > target) {
+        storage_memory_evict_calls(target, FALSE);
+    }
+
+    // Publish the list changes
+    storage_calls_publish();
+
+    storage_unlock();
     return TRUE;
 }
 
+static gpointer
+storage_thread(Storage *storage)
+{
+    g_main_loop_run(storage->loop);
+    return NULL;
+}
+
+void
+storage_stop(Storage *storage)
+{
+    g_return_if_fail(storage != NULL);
+
+    if (storage->thread == NULL)
+        return;
+
+    // Stop storage thread after current packet is processed
+    g_main_loop_quit(storage->loop);
+    g_thread_join(storage->thread);
+    storage->thread = NULL;
+}
+
 void
 storage_free(Storage *storage)
 {
+    // Stop processing packets
+    storage_stop(storage);
+    g_source_destroy(storage->source);
+    g_source_unref(storage->source);
+    g_main_context_unref(g_main_loop_get_context(storage->loop));
+    g_main_loop_unref(storage->loop);
+
     // Remove all calls
     storage_calls_clear();
+    g_sequence_free(storage->calls_displayed);
+    g_sequence_free(storage->calls_sorted);
+    g_sequence_free(storage->calls_time);
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        g_hash_table_destroy(storage->indexes[i]);
+    }
+    if (storage->calls_index != NULL) {
+        g_hash_table_destroy(storage->calls_index);
+    }
+    if (storage->payload_index != NULL) {
+        storage_trigram_index_free(storage->payload_index);
+    }
     // Remove storage pending packets queue
     g_async_queue_unref(storage->queue);
-    // Remove Call-id hash table
+    // Remove Call-id hash tables
     g_hash_table_destroy(storage->callids);
+    g_hash_table_destroy(storage->rejected);
+    g_queue_free(storage->rejected_order);
+    g_mutex_clear(&storage->callids_lock);
+    g_rec_mutex_clear(&storage->lock);
+    // Remove disk storage segments
+    storage_disk_close();
+    // Remove match expression literal
+    g_free(storage->options.match.mliteral);
 }
 
 Storage *
@@ -632,15 +2165,54 @@ storage_new(StorageOpts options, GError **error)
         if (storage->options.match.mregex == NULL) {
             return FALSE;
         }
+
+        // Get the literal text required by the expression for fast prefiltering
+        storage->options.match.mliteral = storage_match_literal(
+            storage->options.match.mexpr,
+            storage->options.match.micase,
+            TRUE,
+            &storage->options.match.mliteral_exact
+        );
+        if (storage->options.match.mliteral != NULL) {
+            storage->options.match.mliteral_len = strlen(storage->options.match.mliteral);
+        }
+    }
+
+    // Prepare disk segments to store packet contents
+    if (storage->options.capture.mode == STORAGE_MODE_DISK) {
+        if (!storage_disk_open(error)) {
+            return NULL;
+        }
     }
 
     // Create a vector to store calls
     storage->calls = g_ptr_array_new_with_free_func(call_destroy);
+    storage->calls_sorted = g_sequence_new(NULL);
+    storage->calls_displayed = g_sequence_new(NULL);
+    storage->calls_time = g_sequence_new(NULL);
+    g_queue_init(&storage->calls_order);
+    g_queue_init(&storage->calls_idle);
 
     // Create hash tables for fast call and stream search
-    storage->callids = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-    storage->streams = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    g_mutex_init(&storage->callids_lock);
+    // Call-IDs are interned, so they are compared by pointer
+    storage->callids = g_hash_table_new_full(g_direct_hash, g_direct_equal, (GDestroyNotify) intern_unref, NULL);
+    storage->rejected = g_hash_table_new_full(g_direct_hash, g_direct_equal, (GDestroyNotify) intern_unref, NULL);
+    storage->rejected_order = g_queue_new();
+    storage->streams = g_hash_table_new_full(storage_stream_key_hash, storage_stream_key_equal, g_free, NULL);
     storage->mrcp_channels = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    // Indexed values are interned, so they are compared by pointer
+    for (guint i = 0; i < CALL_INDEX_COUNT; i++) {
+        storage->indexes[i] = g_hash_table_new_full(
+            g_direct_hash, g_direct_equal, (GDestroyNotify) intern_unref, g_free
+        );
+    }
+
+    // Payload trigram index for payload filters
+    if (storage->options.capture.payload_index) {
+        storage->calls_index = g_hash_table_new(g_direct_hash, g_direct_equal);
+        storage_payload_index_reset();
+    }
 
     // Set default sorting field
     if (attribute_find_by_name(setting_get_value(SETTING_TUI_CL_SORTFIELD)) != NULL) {
@@ -648,26 +2220,41 @@ storage_new(StorageOpts options, GError **error)
         storage->options.sort.asc = (!strcmp(setting_get_value(SETTING_TUI_CL_SORTORDER), "asc"));
     } else {
         // Fallback to default sorting field
-        storage->options.sort.by = attribute_find_by_name(ATTR_CALLINDEX);
+        storage->options.sort.by = attribute_find_by_id(ATTR_ID_CALLINDEX);
         storage->options.sort.asc = TRUE;
     }
 
     // Parsed packet to check
     storage->queue = g_async_queue_new();
 
+    // Packets are processed in their own thread and context
+    g_rec_mutex_init(&storage->lock);
+    GMainContext *context = g_main_context_new();
+    storage->loop = g_main_loop_new(context, FALSE);
+
     // Memory limit checker
     if (storage->options.capture.memory_limit > 0) {
-        g_timeout_add(
-            500,
-            (GSourceFunc) storage_check_memory,
-            GINT_TO_POINTER(storage->options.capture.memory_limit)
-        );
+        GSource *memory_check = g_timeout_source_new(500);
+        g_source_set_callback(memory_check, (GSourceFunc) storage_check_memory, NULL, NULL);
+        g_source_attach(memory_check, context);
+        g_source_unref(memory_check);
+    }
+
+    // Cold storage aging checker
+    if (storage->options.capture.cold_age > 0) {
+        GSource *calls_age = g_timeout_source_new_seconds(1);
+        g_source_set_callback(calls_age, (GSourceFunc) storage_calls_age, NULL, NULL);
+        g_source_attach(calls_age, context);
+        g_source_unref(calls_age);
     }
 
     // Storage check source
-    GSource *source = g_async_queue_source_new(storage->queue, NULL);
-    g_source_set_callback(source, (GSourceFunc) G_CALLBACK(storage_check_packet), NULL, NULL);
-    g_source_attach(source, NULL);
+    storage->source = g_async_queue_source_new(storage->queue, NULL);
+    g_source_set_callback(storage->source, (GSourceFunc) G_CALLBACK(storage_check_packet), NULL, NULL);
+    g_source_attach(storage->source, context);
+
+    // Start processing packets
+    storage->thread = g_thread_new("storage", (GThreadFunc) storage_thread, storage);
 
     return storage;
 }
@@ -31,9 +31,21 @@
 #define __SNGREP_STORAGE_H
 
 #include <glib.h>
+#include "packet/packet_sip.h"
 #include "call.h"
+#include "storage_trigram.h"
 
 #define MAX_SIP_PAYLOAD 10240
+//! Maximum number of remembered rejected Call-IDs
+#define MAX_REJECTED_CALLIDS 8192
+//! Number of evicted calls between calls list purges
+#define STORAGE_MEMORY_EVICT_BATCH 64
+//! Number of call state counters (dialogs that are not calls use state 0)
+#define STORAGE_STATS_STATES (CALL_STATE_COMPLETED + 1)
+//! Number of request method counters
+#define STORAGE_STATS_METHODS (SIP_METHOD_BYE + 1)
+//! Number of response class counters (1XX to 8XX)
+#define STORAGE_STATS_RESPONSES 9
 
 typedef enum
 {
@@ -42,6 +54,15 @@ typedef enum
     STORAGE_MODE_DISK,
 } StorageMode;
 
+//! Memory accounting subsystems
+typedef enum
+{
+    STORAGE_MEMORY_PACKETS = 0,
+    STORAGE_MEMORY_CALLS,
+    STORAGE_MEMORY_REASSEMBLY,
+    STORAGE_MEMORY_COUNT,
+} StorageMemoryType;
+
 typedef enum
 {
     SETTING_STORAGE_MODE_NONE,
@@ -53,8 +74,12 @@ typedef enum
 typedef struct _Storage Storage;
 //! Shorter declaration of sip stats
 typedef struct _StorageStats StorageStats;
+//! Shorter declaration of displayed calls snapshot
+typedef struct _StorageSnapshot StorageSnapshot;
+typedef struct _StorageSnapshotCall StorageSnapshotCall;
 
 //! Shorter declaration of structs
+typedef struct _StorageStreamKey StorageStreamKey;
 typedef struct _StorageOpts StorageOpts;
 typedef struct _StorageSortOpts StorageSortOpts;
 typedef struct _StorageMatchOpts StorageMatchOpts;
@@ -82,6 +107,12 @@ struct _StorageMatchOpts
     gboolean micase;
     //! Compiled match expression
     GRegex *mregex;
+    //! Literal text required by match expression (lowercase if micase)
+    gchar *mliteral;
+    //! Required literal text length
+    gsize mliteral_len;
+    //! Match expression is just the required literal text
+    gboolean mliteral_exact;
 };
 
 struct _StorageCaptureOpts
@@ -98,6 +129,12 @@ struct _StorageCaptureOpts
     gchar *outfile;
     //! Memory limit (in bytes)
     gsize memory_limit;
+    //! Seconds without activity before moving a call to cold storage (0 to disable)
+    guint cold_age;
+    //! Index stored payloads trigrams for payload filtering
+    gboolean payload_index;
+    //! Payload trigram index memory limit (in bytes, 0 for no limit)
+    gsize payload_index_limit;
 };
 
 /**
@@ -109,6 +146,59 @@ struct _StorageStats
     guint total;
     //! Total number of displayed dialogs after filtering
     guint displayed;
+    //! Number of dialogs in each call state (indexed by CallState)
+    guint states[STORAGE_STATS_STATES];
+    //! Total number of messages
+    guint msgs;
+    //! Number of requests of each method (indexed by SipMethods)
+    guint methods[STORAGE_STATS_METHODS];
+    //! Number of responses of each class (indexed by code / 100)
+    guint responses[STORAGE_STATS_RESPONSES];
+};
+
+/**
+ * @brief Copy of displayed calls values
+ *
+ * Snapshots are not modified after being taken, so they can be read
+ * without holding the storage lock while packets are being processed.
+ */
+struct _StorageSnapshot
+{
+    //! Dialogs and messages counters
+    StorageStats stats;
+    //! Accounted memory usage
+    gsize memory_usage;
+    //! Position of the first copied call in displayed calls
+    guint offset;
+    //! Copied displayed calls (StorageSnapshotCall *)
+    GPtrArray *calls;
+};
+
+/**
+ * @brief Copy of a displayed call values
+ */
+struct _StorageSnapshotCall
+{
+    //! Copied call, only for comparison. It may be freed after the copy
+    Call *call;
+    //! First message attribute values (gchar *, NULL if not set)
+    GPtrArray *values;
+};
+
+/**
+ * @brief Streams hash table key
+ *
+ * Packed destination address of a RTP/RTCP stream. Members are ordered
+ * so the structure has no padding and can be hashed and compared as bytes.
+ */
+struct _StorageStreamKey
+{
+    //! Destination IP address in network byte order
+    guint8 addr[16];
+    //! Destination port
+    guint16 port;
+    //! Address family
+    guint16 family;
 };
 
 /**
@@ -135,13 +225,45 @@ struct _Storage
     StorageOpts options;
     //! List of all captured calls
     GPtrArray *calls;
-    //! Changed flag. For interface optimal updates
-    gboolean changed;
+    //! Captured calls in sort options order
+    GSequence *calls_sorted;
+    //! Captured calls matching display filters in sort options order
+    GSequence *calls_displayed;
+    //! Calls list order differs from sorted calls order
+    gboolean sort_changed;
+    //! Captured calls in first message time order
+    GSequence *calls_time;
+    //! Secondary indexes (interned attribute value -> GQueue of calls)
+    GHashTable *indexes[CALL_INDEX_COUNT];
+    //! Payload trigram index (NULL if disabled)
+    StorageTrigramIndex *payload_index;
+    //! First call index added to payload index, older calls are not indexed
+    guint32 payload_index_first;
+    //! Calls by call index, to resolve payload index results
+    GHashTable *calls_index;
+    //! Captured calls in insertion order (for rotation)
+    GQueue calls_order;
+    //! Non cold calls in activity order (for cold storage aging)
+    GQueue calls_idle;
+    //! Number of removed calls pending to be purged from calls list
+    guint calls_removed;
+    //! Incremental dialogs and messages counters
+    StorageStats stats;
+    //! Published version. Increased each time stored calls change
+    gint version;
+    //! Last published version checked by the interface
+    gint version_seen;
     //! Last created id
     guint last_index;
     //! Call-Ids hash table
     GHashTable *callids;
-    //! Streams hash table
+    //! Rejected Call-Ids hash table
+    GHashTable *rejected;
+    //! Rejected Call-Ids in insertion order (for bounded eviction)
+    GQueue *rejected_order;
+    //! Call-Ids tables lock (shared with capture threads)
+    GMutex callids_lock;
+    //! Streams hash table (StorageStreamKey -> Message)
     GHashTable *streams;
     //! MRCPC hash table
     GHashTable *mrcp_channels;
@@ -149,6 +271,14 @@ struct _Storage
     GSource *source;
     //! Packet waiting to be processed
     GAsyncQueue *queue;
+    //! Queued packets not yet processed (including the one being processed)
+    gint pending;
+    //! Storage thread main loop
+    GMainLoop *loop;
+    //! Storage processing thread
+    GThread *thread;
+    //! Stored calls lock (shared with the interface)
+    GRecMutex lock;
 };
 
 /**
@@ -161,6 +291,26 @@ storage_add_packet(Packet *packet);
 void
 storage_check_sip_packet(Packet *packet);
 
+/**
+ * @brief Check if a SIP packet belongs to a dialog that can be stored
+ *
+ * This is called from capture threads by the SIP dissector as soon as the
+ * packet Call-ID, method and To-tag are known, before dissecting its body
+ * and adding it to the storage queue.
+ *
+ * Packets of already admitted dialogs are always accepted. New dialogs are
+ * checked against match options. Call-IDs of dialogs that can never be
+ * stored (INVITE only or complete dialogs options) are remembered in a
+ * bounded cache so later in-dialog packets can be discarded quickly.
+ * Packets not matching the match expression are checked again until one
+ * of the dialog packets matches.
+ *
+ * @param packet Packet with SIP protocol data
+ * @return TRUE if the packet should be queued into storage, FALSE otherwise
+ */
+gboolean
+storage_check_sip_admission(Packet *packet);
+
 void
 storage_check_rtp_packet(Packet *packet);
 
@@ -173,18 +323,44 @@ storage_check_rtcp_packet(Packet *packet);
 Storage *
 storage_new(StorageOpts options, GError **error);
 
+/**
+ * @brief Stop storage processing thread
+ *
+ * Packets still queued after this call will not be processed. This must
+ * be called before closing capture outputs.
+ */
+void
+storage_stop(Storage *storage);
+
 /**
  * @brief Deallocate all memory used for SIP calls
  */
 void
 storage_free(Storage *storage);
 
+/**
+ * @brief Lock stored calls
+ *
+ * Packets are processed in the storage thread. Any other thread must hold
+ * this lock while reading or modifying stored calls, messages and streams.
+ * The lock is recursive, so it can be taken again by the same thread.
+ */
+void
+storage_lock();
+
+/**
+ * @brief Unlock stored calls
+ */
+void
+storage_unlock();
+
 /**
  * @brief Return if the call list has changed
  *
  * Check if the call list has changed since the last time
- * this function was invoked. We consider list has changed when a new
- * call has been added or removed.
+ * this function was invoked. Storage thread publishes a new version
+ * each time calls are added, updated or removed, so this compares the
+ * current version with the last one checked.
  *
  * @return true if list has changed, false otherwise
  */
@@ -216,12 +392,67 @@ storage_calls();
 /**
  * @brief Return stats from call list
  *
- * @param total Total calls processed
- * @param displayed number of calls matching filters
+ * Counters are updated while calls are stored, updated and removed
+ * so no call needs to be checked here.
+ *
+ * @return dialogs and messages counters
  */
 StorageStats
 storage_calls_stats();
 
+/**
+ * @brief Return the calls matching display filters
+ *
+ * Calls are sorted following current sort options. Displayed calls are
+ * updated when calls are added, changed or removed, so this sequence
+ * must not be modified by the caller.
+ *
+ * @return sequence of displayed calls (Call *)
+ */
+GSequence *
+storage_calls_displayed();
+
+/**
+ * @brief Copy the values of a range of displayed calls
+ *
+ * The caller must hold the storage lock while the snapshot is taken,
+ * but not while reading it.
+ *
+ * @param offset Position of the first call in displayed calls
+ * @param count Maximum number of copied calls
+ * @param attributes Copied first message attributes (Attribute *)
+ * @return new allocated snapshot
+ */
+StorageSnapshot *
+storage_calls_snapshot(guint offset, guint count, GPtrArray *attributes);
+
+/**
+ * @brief Free a displayed calls snapshot
+ */
+void
+storage_snapshot_free(StorageSnapshot *snapshot);
+
+/**
+ * @brief Evaluate display filters in all calls again
+ *
+ * Displayed calls are rebuilt with the calls matching current filters.
+ */
+void
+storage_calls_refilter();
+
+/**
+ * @brief Find the first call started at or after the given time
+ *
+ * Calls are searched in the start time index, so this does not depend
+ * on the number of stored calls.
+ *
+ * @param ts Unix timestamp in microseconds
+ * @param displayed Only return calls matching display filters
+ * @return first call started at or after given time or NULL
+ */
+Call *
+storage_calls_find_time(guint64 ts, gboolean displayed);
+
 /**
  * @brief Remove al calls
  *
@@ -240,6 +471,64 @@ storage_calls_clear();
 void
 storage_calls_clear_soft();
 
+/**
+ * @brief Move a cold call contents back to memory
+ *
+ * Compressed frames of the call messages are decompressed and the call
+ * will be moved to cold storage again after being idle for a while.
+ * RTP packets discarded when the call was moved to cold storage can not
+ * be recovered, only their streams statistics are kept.
+ *
+ * Storage lock is taken while restoring the call, so this can be called
+ * from the interface thread.
+ *
+ * @param call Call to be restored from cold storage
+ */
+void
+storage_call_thaw(Call *call);
+
+/**
+ * @brief Fill a stream key with the given destination address
+ *
+ * @param key Stream key to fill
+ * @param dstip Destination IP address text
+ * @param dport Destination port
+ * @return FALSE if the address is not a valid IP address
+ */
+gboolean
+storage_stream_key(StorageStreamKey *key, const gchar *dstip, guint16 dport);
+
+/**
+ * @brief Hash function for streams hash table keys
+ */
+guint
+storage_stream_key_hash(gconstpointer key);
+
+/**
+ * @brief Equal function for streams hash table keys
+ */
+gboolean
+storage_stream_key_equal(gconstpointer a, gconstpointer b);
+
+/**
+ * @brief Extract the longest literal text required by a match expression
+ *
+ * Only top-level literal characters are considered. Any construction that can
+ * not be safely analyzed (alternations, inline options, backreferences, ...)
+ * disables the literal prefilter.
+ *
+ * For case insensitive expressions the literal is returned in ASCII lowercase
+ * and only ASCII characters without unicode case variants are used.
+ *
+ * @param expr Match expression text
+ * @param icase Expression will be matched ignoring case
+ * @param extended Expression is compiled in extended mode
+ * @param exact Set to TRUE if the expression is just the returned literal
+ * @return Required literal text or NULL if none can be extracted
+ */
+gchar *
+storage_match_literal(const gchar *expr, gboolean icase, gboolean extended, gboolean *exact);
+
 /**
  * @brief Get Storage Matching options
  *
@@ -281,8 +570,30 @@ gint
 storage_pending_packets();
 
 /**
- * @brief Get current allocated memory usage
- * @return mallinfo arena memory value
+ * @brief Account allocated or released memory of a subsystem
+ *
+ * This function can be called from any thread.
+ *
+ * Dissected protocol data (headers, SDP media and attribute values) is not
+ * accounted, so real usage is slightly above the accounted bytes.
+ *
+ * @param type Memory accounting subsystem
+ * @param bytes Allocated bytes (negative for released bytes)
+ */
+void
+storage_memory_account(StorageMemoryType type, gssize bytes);
+
+/**
+ * @brief Get current accounted memory usage of a subsystem
+ * @param type Memory accounting subsystem
+ * @return accounted bytes for the subsystem
+ */
+gsize
+storage_memory_usage_by_type(StorageMemoryType type);
+
+/**
+ * @brief Get current accounted memory usage of all subsystems
+ * @return accounted bytes
  */
 gsize
 storage_memory_usage();
@@ -293,5 +604,15 @@ storage_memory_usage();
 gsize
 storage_memory_limit();
 
+/**
+ * @brief Check if payload index has been disabled by its memory limit
+ *
+ * Payload index is created again when stored calls are removed.
+ *
+ * @return TRUE if payload index is enabled but currently not available
+ */
+gboolean
+storage_payload_index_disabled();
+
 
 #endif /* __SNGREP_STORAGE_H */
@@ -0,0 +1,316 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_cold.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in storage_cold.h
+ *
+ */
+#include "config.h"
+#include <glib.h>
+#include <gio/gio.h>
+#include "storage.h"
+#include "storage_cold.h"
+
+//! Last decompressed block cache lock (shared by storage and interface threads)
+static GMutex cache_lock;
+//! Last decompressed block
+static StorageColdBlock *cache_block = NULL;
+//! Last decompressed block contents
+static GBytes *cache_contents = NULL;
+
+/**
+ * @brief Remove last decompressed block from the cache
+ *
+ * Cache lock must be held by the caller.
+ *
+ * @return cached block contents (must be unreferenced) or NULL
+ */
+static GBytes *
+storage_cold_cache_steal()
+{
+    GBytes *contents = cache_contents;
+    if (contents != NULL) {
+        storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) g_bytes_get_size(contents));
+    }
+
+    cache_block = NULL;
+    cache_contents = NULL;
+    return contents;
+}
+
+static void
+storage_cold_cache_clear()
+{
+    GBytes *contents = storage_cold_cache_steal();
+    if (contents != NULL) {
+        g_bytes_unref(contents);
+    }
+}
+
+/**
+ * @brief Compress the contents of the given frames into a new block
+ *
+ * @param frames Packet frames with contents in memory
+ * @param count Number of frames
+ * @param error GError with failure description (optional)
+ * @return TRUE if frames contents have been compressed, FALSE otherwise
+ */
+static gboolean
+storage_cold_block_compress(PacketFrame **frames, guint count, GError **error)
+{
+    g_autoptr(GZlibCompressor) compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_RAW, -1);
+    g_autoptr(GOutputStream) memory = g_memory_output_stream_new_resizable();
+    g_autoptr(GOutputStream) output = g_converter_output_stream_new(memory, G_CONVERTER(compressor));
+
+    gsize size = 0;
+    for (guint i = 0; i < count; i++) {
+        gsize len = 0;
+        gconstpointer data = g_bytes_get_data(frames[i]->data, &len);
+        if (!g_output_stream_write_all(output, data, len, NULL, NULL, error))
+            return FALSE;
+        size += len;
+    }
+
+    // Flush compressor pending data
+    if (!g_output_stream_close(output, NULL, error))
+        return FALSE;
+
+    StorageColdBlock *block = g_malloc0(sizeof(StorageColdBlock));
+    block->contents = g_memory_output_stream_steal_as_bytes(G_MEMORY_OUTPUT_STREAM(memory));
+    block->size = size;
+    block->refcount = (gint) count;
+    storage_memory_account(
+        STORAGE_MEMORY_PACKETS,
+        sizeof(StorageColdBlock) + g_bytes_get_size(block->contents)
+    );
+
+    // Store frames contents location and release them from memory
+    gsize offset = 0;
+    for (guint i = 0; i < count; i++) {
+        PacketFrame *frame = frames[i];
+        frame->block = block;
+        frame->offset = offset;
+        frame->size = (guint32) g_bytes_get_size(frame->data);
+        offset += frame->size;
+
+        storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) frame->size);
+        g_bytes_unref(frame->data);
+        frame->data = NULL;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Decompress the contents of a block
+ *
+ * @param block Compressed block
+ * @return block contents (must be unreferenced) or NULL
+ */
+static GBytes *
+storage_cold_block_decompress(StorageColdBlock *block)
+{
+    g_autoptr(GZlibDecompressor) decompressor = g_zlib_decompressor_new(G_ZLIB_COMPRESSOR_FORMAT_RAW);
+
+    gsize inlen = 0, outlen = 0;
+    const guint8 *in = g_bytes_get_data(block->contents, &inlen);
+    guint8 *out = g_malloc(block->size);
+
+    GConverterResult result;
+    do {
+        gsize read = 0, written = 0;
+        result = g_converter_convert(
+            G_CONVERTER(decompressor),
+            in, inlen,
+            out + outlen, block->size - outlen,
+            G_CONVERTER_INPUT_AT_END,
+            &read, &written, NULL
+        );
+
+        // Stop on errors or when no progress has been made
+        if (result == G_CONVERTER_ERROR || (read == 0 && written == 0 && result != G_CONVERTER_FINISHED)) {
+            g_free(out);
+            return NULL;
+        }
+
+        in += read;
+        inlen -= read;
+        outlen += written;
+    } while (result != G_CONVERTER_FINISHED);
+
+    if (outlen != block->size) {
+        g_free(out);
+        return NULL;
+    }
+
+    return g_bytes_new_take(out, block->size);
+}
+
+/**
+ * @brief Get the uncompressed contents of a block using the cache
+ *
+ * @param block Compressed block
+ * @return block contents reference (must be unreferenced) or NULL
+ */
+static GBytes *
+storage_cold_block_contents(StorageColdBlock *block)
+{
+    g_mutex_lock(&cache_lock);
+    if (block == cache_block) {
+        GBytes *contents = g_bytes_ref(cache_contents);
+        g_mutex_unlock(&cache_lock);
+        return contents;
+    }
+    g_mutex_unlock(&cache_lock);
+
+    GBytes *contents = storage_cold_block_decompress(block);
+    if (contents == NULL)
+        return NULL;
+
+    // Replace last decompressed block
+    g_mutex_lock(&cache_lock);
+    storage_cold_cache_clear();
+    cache_block = block;
+    cache_contents = g_bytes_ref(contents);
+    storage_memory_account(STORAGE_MEMORY_PACKETS, block->size);
+    g_mutex_unlock(&cache_lock);
+
+    return contents;
+}
+
+void
+storage_cold_block_unref(StorageColdBlock *block)
+{
+    g_return_if_fail(block != NULL);
+
+    if (!g_atomic_int_dec_and_test(&block->refcount))
+        return;
+
+    g_mutex_lock(&cache_lock);
+    if (block == cache_block)
+        storage_cold_cache_clear();
+    g_mutex_unlock(&cache_lock);
+
+    storage_memory_account(
+        STORAGE_MEMORY_PACKETS,
+        -(gssize) (sizeof(StorageColdBlock) + g_bytes_get_size(block->contents))
+    );
+    g_bytes_unref(block->contents);
+    g_free(block);
+}
+
+gboolean
+storage_cold_compress_frames(GPtrArray *frames, GError **error)
+{
+    g_return_val_if_fail(frames != NULL, FALSE);
+
+    // Frames with contents in memory
+    g_autoptr(GPtrArray) pending = g_ptr_array_new();
+    for (guint i = 0; i < g_ptr_array_len(frames); i++) {
+        PacketFrame *frame = g_ptr_array_index(frames, i);
+        if (frame->data != NULL && g_bytes_get_size(frame->data) > 0) {
+            g_ptr_array_add(pending, frame);
+        }
+    }
+
+    // Group consecutive frames until the block is full
+    guint first = 0;
+    while (first < g_ptr_array_len(pending)) {
+        guint last = first;
+        gsize size = 0;
+        while (last < g_ptr_array_len(pending)) {
+            PacketFrame *frame = g_ptr_array_index(pending, last);
+            gsize len = g_bytes_get_size(frame->data);
+            if (size > 0 && size + len > STORAGE_COLD_BLOCK_SIZE)
+                break;
+            size += len;
+            last++;
+        }
+
+        PacketFrame **block_frames = (PacketFrame **) pending->pdata + first;
+        if (!storage_cold_block_compress(block_frames, last - first, error))
+            return FALSE;
+
+        first = last;
+    }
+
+    return TRUE;
+}
+
+void
+storage_cold_decompress_frames(GPtrArray *frames)
+{
+    g_return_if_fail(frames != NULL);
+
+    // Block frames are consecutive, so each block is decompressed once
+    StorageColdBlock *block = NULL;
+    g_autoptr(GBytes) contents = NULL;
+
+    for (guint i = 0; i < g_ptr_array_len(frames); i++) {
+        PacketFrame *frame = g_ptr_array_index(frames, i);
+        if (frame->block == NULL)
+            continue;
+
+        if (frame->block != block) {
+            g_clear_pointer(&contents, g_bytes_unref);
+            block = frame->block;
+
+            // Decompressed contents are now accounted by its frames
+            g_mutex_lock(&cache_lock);
+            if (block == cache_block) {
+                contents = storage_cold_cache_steal();
+            }
+            g_mutex_unlock(&cache_lock);
+
+            if (contents == NULL) {
+                contents = storage_cold_block_decompress(block);
+            }
+        }
+
+        if (contents == NULL)
+            continue;
+
+        // Frame contents share the decompressed block data
+        frame->data = g_bytes_new_from_bytes(contents, frame->offset, frame->size);
+        storage_memory_account(STORAGE_MEMORY_PACKETS, frame->size);
+
+        storage_cold_block_unref(frame->block);
+        frame->block = NULL;
+        frame->offset = 0;
+        frame->size = 0;
+    }
+}
+
+GBytes *
+storage_cold_load_frame(const PacketFrame *frame)
+{
+    g_return_val_if_fail(frame != NULL, NULL);
+    g_return_val_if_fail(frame->block != NULL, NULL);
+
+    g_autoptr(GBytes) contents = storage_cold_block_contents(frame->block);
+    if (contents == NULL)
+        return NULL;
+
+    return g_bytes_new_from_bytes(contents, frame->offset, frame->size);
+}
@@ -0,0 +1,106 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_cold.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage compressed packet frames of cold calls
+ *
+ * Calls without activity for a while are moved to cold storage: their
+ * packet frame contents are compressed in blocks and released from memory.
+ * Packet frames only keep the block, offset and size of their contents,
+ * that are decompressed back on demand when required.
+ *
+ */
+
+#ifndef __SNGREP_STORAGE_COLD_H
+#define __SNGREP_STORAGE_COLD_H
+
+#include <glib.h>
+#include "packet/packet.h"
+
+//! Maximum uncompressed size of each block
+#define STORAGE_COLD_BLOCK_SIZE (64 * 1024)
+
+//! Shorter declaration of cold storage structures
+typedef struct _StorageColdBlock StorageColdBlock;
+
+/**
+ * @brief Compressed contents of consecutive packet frames
+ */
+struct _StorageColdBlock
+{
+    //! Number of frames with contents in this block
+    gint refcount;
+    //! Compressed frames contents
+    GBytes *contents;
+    //! Uncompressed frames contents size
+    gsize size;
+};
+
+/**
+ * @brief Move frames contents to compressed blocks
+ *
+ * Frames contents are compressed in blocks of STORAGE_COLD_BLOCK_SIZE and
+ * released from memory. Frames without contents in memory are ignored.
+ *
+ * @param frames Packet frames array (PacketFrame *)
+ * @param error GError with failure description (optional)
+ * @return TRUE if all frames contents have been compressed, FALSE otherwise
+ */
+gboolean
+storage_cold_compress_frames(GPtrArray *frames, GError **error);
+
+/**
+ * @brief Move frames contents back to memory
+ *
+ * Each compressed block is decompressed once and its frames contents
+ * share the decompressed data.
+ *
+ * @param frames Packet frames array (PacketFrame *)
+ */
+void
+storage_cold_decompress_frames(GPtrArray *frames);
+
+/**
+ * @brief Load frame contents from a compressed block
+ *
+ * Last decompressed block is cached, so loading all frames of a block
+ * only decompresses it once.
+ *
+ * @param frame Packet frame with contents in a compressed block
+ * @return frame contents or NULL if they can not be loaded
+ */
+GBytes *
+storage_cold_load_frame(const PacketFrame *frame);
+
+/**
+ * @brief Release a frame reference to its compressed block
+ *
+ * Block memory is released when no frame references it.
+ *
+ * @param block Compressed block
+ */
+void
+storage_cold_block_unref(StorageColdBlock *block);
+
+#endif /* __SNGREP_STORAGE_COLD_H */
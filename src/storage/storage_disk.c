@@ -0,0 +1,252 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_disk.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in storage_disk.h
+ *
+ */
+
+#include "config.h"
+#include <errno.h>
+#include <unistd.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include "storage.h"
+#include "storage_disk.h"
+
+/**
+ * @brief Global Structure with disk storage information
+ */
+static StorageDisk *disk = NULL;
+
+GQuark
+storage_disk_error_quark()
+{
+    return g_quark_from_static_string("storage-disk");
+}
+
+static StorageDiskSegment *
+storage_disk_segment_new(guint id, GError **error)
+{
+    StorageDiskSegment *segment = g_malloc0(sizeof(StorageDiskSegment));
+
+    g_autofree gchar *filename = g_strdup_printf("segment-%05u.dat", id);
+    segment->path = g_build_filename(disk->path, filename, NULL);
+    segment->file = g_fopen(segment->path, "w+b");
+
+    if (segment->file == NULL) {
+        g_set_error(error,
+                    STORAGE_DISK_ERROR,
+                    STORAGE_DISK_ERROR_SEGMENT_OPEN,
+                    "Unable to create storage segment %s: %s",
+                    segment->path, g_strerror(errno));
+        g_free(segment->path);
+        g_free(segment);
+        return NULL;
+    }
+
+    return segment;
+}
+
+static void
+storage_disk_segment_free(StorageDiskSegment *segment)
+{
+    if (segment->file != NULL)
+        fclose(segment->file);
+    if (segment->contents != NULL)
+        g_bytes_unref(segment->contents);
+    g_unlink(segment->path);
+    g_free(segment->path);
+    g_free(segment);
+}
+
+gboolean
+storage_disk_open(GError **error)
+{
+    g_return_val_if_fail(disk == NULL, FALSE);
+
+    disk = g_malloc0(sizeof(StorageDisk));
+    g_mutex_init(&disk->lock);
+    disk->segments = g_ptr_array_new_with_free_func((GDestroyNotify) storage_disk_segment_free);
+
+    // Create a temporary directory for this capture segments
+    disk->path = g_dir_make_tmp("sngrep-XXXXXX", error);
+    if (disk->path == NULL) {
+        storage_disk_close();
+        return FALSE;
+    }
+
+    // Create first segment
+    StorageDiskSegment *segment = storage_disk_segment_new(0, error);
+    if (segment == NULL) {
+        storage_disk_close();
+        return FALSE;
+    }
+    g_ptr_array_add(disk->segments, segment);
+
+    return TRUE;
+}
+
+void
+storage_disk_close()
+{
+    if (disk == NULL)
+        return;
+
+    // Remove all segment files
+    g_ptr_array_free(disk->segments, TRUE);
+
+    // Remove temporary directory
+    if (disk->path != NULL) {
+        g_rmdir(disk->path);
+        g_free(disk->path);
+    }
+
+    g_mutex_clear(&disk->lock);
+    g_free(disk);
+    disk = NULL;
+}
+
+gboolean
+storage_disk_store_frame(PacketFrame *frame, GError **error)
+{
+    g_return_val_if_fail(disk != NULL, FALSE);
+    g_return_val_if_fail(frame->data != NULL, FALSE);
+
+    gsize size = 0;
+    gconstpointer data = g_bytes_get_data(frame->data, &size);
+
+    g_mutex_lock(&disk->lock);
+
+    guint id = g_ptr_array_len(disk->segments) - 1;
+    StorageDiskSegment *segment = g_ptr_array_index(disk->segments, id);
+
+    // Start a new segment when current one is full
+    if (segment->size > 0 && segment->size + size > STORAGE_DISK_SEGMENT_SIZE) {
+        StorageDiskSegment *next = storage_disk_segment_new(id + 1, error);
+        if (next == NULL) {
+            g_mutex_unlock(&disk->lock);
+            return FALSE;
+        }
+
+        // Full segments are never written again
+        fclose(segment->file);
+        segment->file = NULL;
+
+        g_ptr_array_add(disk->segments, next);
+        segment = next;
+        id++;
+    }
+
+    // Append frame contents to the segment
+    if (fwrite(data, 1, size, segment->file) != size) {
+        g_set_error(error,
+                    STORAGE_DISK_ERROR,
+                    STORAGE_DISK_ERROR_SEGMENT_WRITE,
+                    "Unable to write storage segment %s: %s",
+                    segment->path, g_strerror(errno));
+        g_mutex_unlock(&disk->lock);
+        return FALSE;
+    }
+
+    // Store frame contents location
+    frame->segment = id;
+    frame->offset = segment->size;
+    frame->size = (guint32) size;
+    segment->size += size;
+
+    g_mutex_unlock(&disk->lock);
+
+    // Release frame contents from memory
+    storage_memory_account(STORAGE_MEMORY_PACKETS, -(gssize) size);
+    g_bytes_unref(frame->data);
+    frame->data = NULL;
+
+    return TRUE;
+}
+
+/**
+ * @brief Read frame contents from a segment that is still being written
+ *
+ * Active segments grow with every stored frame, so they are read instead of
+ * being mapped again after each write.
+ */
+static GBytes *
+storage_disk_segment_read(StorageDiskSegment *segment, guint64 offset, gsize size)
+{
+    // Ensure buffered frames are written before reading them
+    if (fflush(segment->file) != 0)
+        return NULL;
+
+    gchar *data = g_malloc(size);
+    if (pread(fileno(segment->file), data, size, (off_t) offset) != (gssize) size) {
+        g_free(data);
+        return NULL;
+    }
+
+    return g_bytes_new_take(data, size);
+}
+
+GBytes *
+storage_disk_load_frame(const PacketFrame *frame)
+{
+    g_return_val_if_fail(disk != NULL, NULL);
+    g_return_val_if_fail(frame != NULL, NULL);
+
+    g_mutex_lock(&disk->lock);
+
+    if (frame->segment >= g_ptr_array_len(disk->segments)) {
+        g_mutex_unlock(&disk->lock);
+        return NULL;
+    }
+
+    StorageDiskSegment *segment = g_ptr_array_index(disk->segments, frame->segment);
+
+    // Segment is still being written
+    if (segment->file != NULL) {
+        GBytes *data = storage_disk_segment_read(segment, frame->offset, frame->size);
+        g_mutex_unlock(&disk->lock);
+        return data;
+    }
+
+    // Full segments are never written again, map them only once
+    if (segment->contents == NULL) {
+        GMappedFile *map = g_mapped_file_new(segment->path, FALSE, NULL);
+        if (map == NULL) {
+            g_mutex_unlock(&disk->lock);
+            return NULL;
+        }
+
+        segment->contents = g_mapped_file_get_bytes(map);
+        g_mapped_file_unref(map);
+    }
+
+    GBytes *data = NULL;
+    if (g_bytes_get_size(segment->contents) >= frame->offset + frame->size) {
+        data = g_bytes_new_from_bytes(segment->contents, frame->offset, frame->size);
+    }
+
+    g_mutex_unlock(&disk->lock);
+    return data;
+}
@@ -0,0 +1,132 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_disk.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage packet frames stored on disk
+ *
+ * When storage mode is set to disk, stored packet frame contents are
+ * appended to segment files in a temporary directory and released from
+ * memory. Packet frames only keep the segment, offset and size of their
+ * contents, that are mapped back on demand when required.
+ *
+ */
+
+#ifndef __SNGREP_STORAGE_DISK_H
+#define __SNGREP_STORAGE_DISK_H
+
+#include <stdio.h>
+#include <glib.h>
+#include "packet/packet.h"
+
+//! Maximum size of each segment file
+#define STORAGE_DISK_SEGMENT_SIZE (64 * 1024 * 1024)
+
+//! Error reporting
+#define STORAGE_DISK_ERROR (storage_disk_error_quark())
+
+//! Error codes
+typedef enum
+{
+    STORAGE_DISK_ERROR_DIRECTORY = 0,
+    STORAGE_DISK_ERROR_SEGMENT_OPEN,
+    STORAGE_DISK_ERROR_SEGMENT_WRITE,
+} StorageDiskErrors;
+
+//! Shorter declaration of disk storage structures
+typedef struct _StorageDisk StorageDisk;
+typedef struct _StorageDiskSegment StorageDiskSegment;
+
+/**
+ * @brief Append-only file with packet frame contents
+ */
+struct _StorageDiskSegment
+{
+    //! Segment file path
+    gchar *path;
+    //! Segment file descriptor (only while segment is being written)
+    FILE *file;
+    //! Segment written bytes
+    guint64 size;
+    //! Mapped segment contents (only once segment is full)
+    GBytes *contents;
+};
+
+/**
+ * @brief Disk storage information
+ */
+struct _StorageDisk
+{
+    //! Temporary directory for segment files
+    gchar *path;
+    //! Segment files (StorageDiskSegment *)
+    GPtrArray *segments;
+    //! Segments lock (written by storage, read by interface)
+    GMutex lock;
+};
+
+GQuark
+storage_disk_error_quark();
+
+/**
+ * @brief Create disk storage temporary directory and first segment
+ *
+ * @param error GError with failure description (optional)
+ * @return TRUE if disk storage is ready, FALSE otherwise
+ */
+gboolean
+storage_disk_open(GError **error);
+
+/**
+ * @brief Remove all disk storage segment files and directory
+ */
+void
+storage_disk_close();
+
+/**
+ * @brief Move frame contents to disk storage
+ *
+ * Frame contents are appended to the current segment and released from
+ * memory. The frame keeps the location of its contents in the segment.
+ *
+ * @param frame Packet frame with contents in memory
+ * @param error GError with failure description (optional)
+ * @return TRUE if frame contents have been stored, FALSE otherwise
+ */
+gboolean
+storage_disk_store_frame(PacketFrame *frame, GError **error);
+
+/**
+ * @brief Load frame contents from disk storage
+ *
+ * Full segment files are mapped into memory once and the frame contents are
+ * returned without copying them. Frames in the segment still being written
+ * are read from the segment file.
+ *
+ * @param frame Packet frame with contents stored in disk
+ * @return frame contents or NULL if they can not be loaded
+ */
+GBytes *
+storage_disk_load_frame(const PacketFrame *frame);
+
+#endif /* __SNGREP_STORAGE_DISK_H */
@@ -0,0 +1,236 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_trigram.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Source of functions defined in storage_trigram.h
+ *
+ */
+#include "config.h"
+#include <glib.h>
+#include "storage_trigram.h"
+
+/**
+ * @brief Get the trigram key starting at the given data position
+ */
+static inline guint32
+storage_trigram_key(const gchar *data)
+{
+    return ((guint32) (guint8) g_ascii_tolower(data[0]) << 16)
+           | ((guint32) (guint8) g_ascii_tolower(data[1]) << 8)
+           | (guint32) (guint8) g_ascii_tolower(data[2]);
+}
+
+/**
+ * @brief Add an identifier to a sorted posting list
+ *
+ * @return TRUE if the identifier has been added, FALSE if already present
+ */
+static gboolean
+storage_trigram_posting_add(GArray *posting, guint32 id)
+{
+    // Most identifiers are added to the end of the list
+    guint32 last = (posting->len > 0) ? g_array_index(posting, guint32, posting->len - 1) : 0;
+    if (posting->len == 0 || last < id) {
+        g_array_append_val(posting, id);
+        return TRUE;
+    }
+
+    // Same identifier adding its data again
+    if (last == id)
+        return FALSE;
+
+    // Find the insert position of older identifiers
+    guint lo = 0, hi = posting->len;
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+        guint32 value = g_array_index(posting, guint32, mid);
+        if (value == id)
+            return FALSE;
+        if (value < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    g_array_insert_val(posting, lo, id);
+    return TRUE;
+}
+
+/**
+ * @brief Check if a sorted posting list contains an identifier
+ */
+static gboolean
+storage_trigram_posting_contains(GArray *posting, guint32 id)
+{
+    guint lo = 0, hi = posting->len;
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+        guint32 value = g_array_index(posting, guint32, mid);
+        if (value == id)
+            return TRUE;
+        if (value < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return FALSE;
+}
+
+static gint
+storage_trigram_posting_len_cmp(gconstpointer a, gconstpointer b)
+{
+    const GArray *one = *(const GArray **) a;
+    const GArray *two = *(const GArray **) b;
+    return (one->len > two->len) - (one->len < two->len);
+}
+
+static void
+storage_trigram_posting_free(GArray *posting)
+{
+    g_array_free(posting, TRUE);
+}
+
+StorageTrigramIndex *
+storage_trigram_index_new()
+{
+    StorageTrigramIndex *index = g_malloc0(sizeof(StorageTrigramIndex));
+    index->postings = g_hash_table_new_full(
+        g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) storage_trigram_posting_free
+    );
+    return index;
+}
+
+void
+storage_trigram_index_free(StorageTrigramIndex *index)
+{
+    g_return_if_fail(index != NULL);
+    g_hash_table_destroy(index->postings);
+    g_free(index);
+}
+
+void
+storage_trigram_index_clear(StorageTrigramIndex *index)
+{
+    g_return_if_fail(index != NULL);
+    g_hash_table_remove_all(index->postings);
+    index->size = 0;
+}
+
+void
+storage_trigram_index_add(StorageTrigramIndex *index, guint32 id, const gchar *data, gsize len)
+{
+    g_return_if_fail(index != NULL);
+
+    if (data == NULL || len < 3)
+        return;
+
+    guint32 last = G_MAXUINT32;
+    for (gsize i = 0; i + 2 < len; i++) {
+        guint32 key = storage_trigram_key(data + i);
+
+        // Skip repeated trigrams (like padding or line separators)
+        if (key == last)
+            continue;
+        last = key;
+
+        GArray *posting = g_hash_table_lookup(index->postings, GUINT_TO_POINTER(key));
+        if (posting == NULL) {
+            posting = g_array_sized_new(FALSE, FALSE, sizeof(guint32), 4);
+            g_hash_table_insert(index->postings, GUINT_TO_POINTER(key), posting);
+            index->size += STORAGE_TRIGRAM_POSTING_SIZE;
+        }
+
+        if (storage_trigram_posting_add(posting, id)) {
+            index->size += sizeof(guint32);
+        }
+    }
+}
+
+GArray *
+storage_trigram_index_lookup(StorageTrigramIndex *index, const gchar *text, gsize len)
+{
+    g_return_val_if_fail(index != NULL, NULL);
+
+    if (text == NULL || len < 3)
+        return NULL;
+
+    GArray *result = g_array_new(FALSE, FALSE, sizeof(guint32));
+
+    // Get the posting list of each text trigram
+    g_autoptr(GPtrArray) postings = g_ptr_array_new();
+    for (gsize i = 0; i + 2 < len; i++) {
+        GArray *posting = g_hash_table_lookup(index->postings, GUINT_TO_POINTER(storage_trigram_key(text + i)));
+        // No data contains this trigram
+        if (posting == NULL)
+            return result;
+        g_ptr_array_add(postings, posting);
+    }
+
+    // Start with the shortest posting list
+    g_ptr_array_sort(postings, storage_trigram_posting_len_cmp);
+    GArray *shortest = g_ptr_array_index(postings, 0);
+
+    for (guint i = 0; i < shortest->len; i++) {
+        guint32 id = g_array_index(shortest, guint32, i);
+        gboolean found = TRUE;
+        for (guint j = 1; j < postings->len && found; j++) {
+            found = storage_trigram_posting_contains(g_ptr_array_index(postings, j), id);
+        }
+        if (found) {
+            g_array_append_val(result, id);
+        }
+    }
+
+    return result;
+}
+
+void
+storage_trigram_index_prune(StorageTrigramIndex *index, StorageTrigramKeepFunc keep, gpointer user_data)
+{
+    g_return_if_fail(index != NULL);
+    g_return_if_fail(keep != NULL);
+
+    GHashTableIter iter;
+    GArray *posting;
+    g_hash_table_iter_init(&iter, index->postings);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &posting)) {
+        guint len = 0;
+        for (guint i = 0; i < posting->len; i++) {
+            guint32 id = g_array_index(posting, guint32, i);
+            if (keep(id, user_data)) {
+                g_array_index(posting, guint32, len++) = id;
+            }
+        }
+        index->size -= (posting->len - len) * sizeof(guint32);
+
+        if (len == 0) {
+            g_hash_table_iter_remove(&iter);
+            index->size -= STORAGE_TRIGRAM_POSTING_SIZE;
+        } else {
+            g_array_set_size(posting, len);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file storage_trigram.h
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * @brief Functions to manage payload trigram index
+ *
+ * Trigram index stores, for each sequence of three bytes found in stored
+ * payloads, the sorted list of call indexes whose payloads contain it.
+ * Bytes are indexed in ASCII lowercase, so the index can be used for case
+ * insensitive searches.
+ *
+ * Searching a literal text returns the calls containing all its trigrams.
+ * This is a superset of the calls containing the literal, so the results
+ * must be confirmed against the payloads.
+ *
+ */
+
+#ifndef __SNGREP_STORAGE_TRIGRAM_H
+#define __SNGREP_STORAGE_TRIGRAM_H
+
+#include <glib.h>
+
+//! Approximate memory used by each trigram posting list
+#define STORAGE_TRIGRAM_POSTING_SIZE 64
+
+//! Shorter declaration of trigram index structure
+typedef struct _StorageTrigramIndex StorageTrigramIndex;
+
+/**
+ * @brief Check if an indexed identifier is still valid
+ *
+ * @param id Identifier added to the index
+ * @param user_data Data passed to prune function
+ * @return TRUE to keep the identifier, FALSE to remove it
+ */
+typedef gboolean (*StorageTrigramKeepFunc)(guint32 id, gpointer user_data);
+
+/**
+ * @brief Payload trigram inverted index
+ */
+struct _StorageTrigramIndex
+{
+    //! Posting lists (trigram -> GArray of sorted guint32 identifiers)
+    GHashTable *postings;
+    //! Approximate memory used by the index in bytes
+    gsize size;
+};
+
+/**
+ * @brief Create a new empty trigram index
+ */
+StorageTrigramIndex *
+storage_trigram_index_new();
+
+/**
+ * @brief Deallocate a trigram index and all its posting lists
+ */
+void
+storage_trigram_index_free(StorageTrigramIndex *index);
+
+/**
+ * @brief Remove all posting lists of a trigram index
+ */
+void
+storage_trigram_index_clear(StorageTrigramIndex *index);
+
+/**
+ * @brief Add all trigrams of the given data to the index
+ *
+ * Identifiers are expected to be added in mostly increasing order, so
+ * posting lists are usually appended.
+ *
+ * @param index Trigram index
+ * @param id Identifier of the data owner
+ * @param data Data to be indexed
+ * @param len Data length
+ */
+void
+storage_trigram_index_add(StorageTrigramIndex *index, guint32 id, const gchar *data, gsize len);
+
+/**
+ * @brief Get the identifiers whose data contains all trigrams of a text
+ *
+ * @param index Trigram index
+ * @param text Text to search (compared in ASCII lowercase)
+ * @param len Text length
+ * @return sorted array of identifiers (guint32) or NULL if the text is
+ * too short to be searched in the index
+ */
+GArray *
+storage_trigram_index_lookup(StorageTrigramIndex *index, const gchar *text, gsize len);
+
+/**
+ * @brief Remove identifiers no longer valid from all posting lists
+ *
+ * @param index Trigram index
+ * @param keep Function to check if an identifier must be kept
+ * @param user_data Data passed to keep function
+ */
+void
+storage_trigram_index_prune(StorageTrigramIndex *index, StorageTrigramKeepFunc keep, gpointer user_data);
+
+#endif /* __SNGREP_STORAGE_TRIGRAM_H */
@@ -37,7 +37,11 @@
 Stream *
 stream_new(StreamType type, Message *msg, PacketSdpMedia *media)
 {
-    Stream *stream = g_malloc0(sizeof(Stream));
+    g_return_val_if_fail(msg != NULL, NULL);
+    g_return_val_if_fail(msg->call != NULL, NULL);
+
+    // Streams are allocated in the call memory arena
+    Stream *stream = arena_alloc0(msg->call->arena, sizeof(Stream));
 
     // Initialize all fields
     stream->type = type;
@@ -50,10 +54,10 @@ stream_new(StreamType type, Message *msg, PacketSdpMedia *media)
 void
 stream_free(Stream *stream)
 {
+    // Stream structure is released with the call arena
     g_ptr_array_free(stream->packets, TRUE);
     address_free(stream->src);
     address_free(stream->dst);
-    g_free(stream);
 }
 
 void
@@ -76,6 +80,34 @@ stream_set_ssrc(Stream *stream, guint32 ssrc)
     stream->ssrc = ssrc;
 }
 
+static guint
+stream_address_hash(const Address address)
+{
+    // Addresses without IP are equal regardless the port
+    if (address.ip == NULL)
+        return 0;
+
+    return g_str_hash(address.ip) * 31 + address.port;
+}
+
+guint
+stream_hash(gconstpointer stream)
+{
+    const Stream *s = stream;
+    guint hash = stream_address_hash(s->src);
+    hash = hash * 31 + stream_address_hash(s->dst);
+    return hash * 31 + s->ssrc;
+}
+
+gboolean
+stream_equal(gconstpointer a, gconstpointer b)
+{
+    const Stream *one = a, *two = b;
+    return one->ssrc == two->ssrc
+           && addressport_equals(one->src, two->src)
+           && addressport_equals(one->dst, two->dst);
+}
+
 static void
 stream_rtp_analyze(Stream *stream, Packet *packet)
 {
@@ -162,7 +194,6 @@ void
 stream_add_packet(Stream *stream, Packet *packet)
 {
     stream->lasttm = g_get_monotonic_time();
-    stream->changed = TRUE;
     stream->packet_count++;
     if (stream->first_ts == 0) {
         stream->first_ts = packet_time(packet);
@@ -64,8 +64,6 @@ struct _Stream
     guint64 first_ts;
     //! Last time this stream was updated
     gint64 lasttm;
-    //! Changed since last checked flag
-    gboolean changed;
     //! Format of first received packet of stre
     guint8 fmtcode;
     //! Synchronization Source Identifier
@@ -124,6 +122,29 @@ stream_set_ssrc(Stream *stream, guint32 ssrc);
 void
 stream_add_packet(Stream *stream, Packet *packet);
 
+/**
+ * @brief Hash a stream by its source, destination and SSRC
+ *
+ * Hash function to be used in hash tables with Stream keys
+ *
+ * @param stream Stream pointer
+ * @return hash value of stream identifying data
+ */
+guint
+stream_hash(gconstpointer stream);
+
+/**
+ * @brief Check if two streams have the same source, destination and SSRC
+ *
+ * Equal function to be used in hash tables with Stream keys
+ *
+ * @param a Stream pointer
+ * @param b Stream pointer
+ * @return TRUE if both streams have the same identifying data
+ */
+gboolean
+stream_equal(gconstpointer a, gconstpointer b);
+
 guint
 stream_get_count(Stream *stream);
 
@@ -29,6 +29,7 @@
 
 #include "config.h"
 #include <string.h>
+#include "tui/tui.h"
 #include "tui/theme.h"
 #include "tui/keybinding.h"
 #include "tui/dialog.h"
@@ -102,7 +103,9 @@ dialog_run(const char *fmt, ...)
 
     // Wait for input
     keypad(win, TRUE);
+    tui_input_wait_begin();
     wgetch(win);
+    tui_input_wait_end();
 
     delwin(win);
     return 1;
@@ -292,7 +295,9 @@ dialog_confirm(const char *title, const char *text, const char *options)
         }
 
         // Get pressed key
+        tui_input_wait_begin();
         key = wgetch(dialog_win);
+        tui_input_wait_end();
 
         // Check actions for this key
         KeybindingAction action = ACTION_UNKNOWN;
@@ -332,3 +337,83 @@ dialog_confirm(const char *title, const char *text, const char *options)
     curs_set(curs);
     return selected;
 }
+
+gchar *
+dialog_input(const char *title, const char *text)
+{
+    WINDOW *dialog_win;
+    gchar value[DIALOG_MIN_WIDTH - 3] = { 0 };
+    gsize len = 0;
+    gint key, curs;
+    gint height = 6;
+    gint width = DIALOG_MIN_WIDTH;
+    gboolean accepted = FALSE;
+
+    // Create a new panel and show centered
+    dialog_win = newwin(height, width, (LINES - height) / 2, (COLS - width) / 2);
+    keypad(dialog_win, TRUE);
+    curs = curs_set(1);
+
+    // Set the window title
+    mvwprintw(dialog_win, 1, (width - strlen(title)) / 2, title);
+
+    // Write border and boxes around the window
+    wattron(dialog_win, COLOR_PAIR(CP_BLUE_ON_DEF));
+    box(dialog_win, 0, 0);
+    mvwhline(dialog_win, 2, 1, ACS_HLINE, width);
+    mvwaddch(dialog_win, 2, 0, ACS_LTEE);
+    mvwaddch(dialog_win, 2, width - 1, ACS_RTEE);
+    wattroff(dialog_win, COLOR_PAIR(CP_BLUE_ON_DEF));
+
+    // Input field description
+    wattron(dialog_win, COLOR_PAIR(CP_CYAN_ON_DEF));
+    mvwprintw(dialog_win, 3, 2, "%.*s", width - 4, text);
+    wattroff(dialog_win, COLOR_PAIR(CP_CYAN_ON_DEF));
+
+    for (;;) {
+        // Draw current input value
+        wattron(dialog_win, A_REVERSE);
+        mvwhline(dialog_win, 4, 2, ' ', width - 4);
+        mvwprintw(dialog_win, 4, 2, "%s", value);
+        wattroff(dialog_win, A_REVERSE);
+        wmove(dialog_win, 4, 2 + len);
+
+        // Get pressed key
+        tui_input_wait_begin();
+        key = wgetch(dialog_win);
+        tui_input_wait_end();
+
+        // Check actions for this key
+        KeybindingAction action = ACTION_UNKNOWN;
+        while ((action = key_find_action(key, action)) != ACTION_UNKNOWN) {
+            // Check if we handle this action
+            switch (action) {
+                case ACTION_PRINTABLE:
+                    if (len < sizeof(value) - 1) {
+                        value[len++] = (gchar) key;
+                    }
+                    break;
+                case ACTION_BACKSPACE:
+                    if (len > 0) {
+                        value[--len] = '\0';
+                    }
+                    break;
+                case ACTION_CONFIRM:
+                    accepted = TRUE;
+                    goto done;
+                case ACTION_PREV_SCREEN:
+                    goto done;
+                default:
+                    // Parse next action
+                    continue;
+            }
+            // key handled successfully
+            break;
+        }
+    }
+
+    done:
+    delwin(dialog_win);
+    curs_set(curs);
+    return (accepted) ? g_strdup(value) : NULL;
+}
@@ -94,5 +94,15 @@ dialog_progress_destroy(WINDOW *win);
 int
 dialog_confirm(const char *title, const char *text, const char *options);
 
+/**
+ * @brief Create a new dialog to request a single line of text
+ *
+ * @param title Title displayed in the top of the dialog
+ * @param text Text displayed above the input field
+ * @return the entered text (to be freed by caller) or NULL if cancelled
+ */
+gchar *
+dialog_input(const char *title, const char *text);
+
 
 #endif // __SNGREP_DIALOG_H
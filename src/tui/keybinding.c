@@ -96,6 +96,7 @@ Keybinding bindings[ACTION_SENTINEL] = {
     { ACTION_SORT_SWAP,        "sortswap",        { 'z' },                                           1 },
     { ACTION_TOGGLE_TIME,      "toggletime",      { 'w' },                                           1 },
     { ACTION_TELEVT_MODE,      "televtmode",      { 'Z' },                                           1 },
+    { ACTION_JUMP_TIME,        "jumptime",        { 'g' },                                           1 },
 };
 
 /**
@@ -119,6 +119,7 @@ typedef enum
     ACTION_SORT_SWAP,
     ACTION_TOGGLE_TIME,
     ACTION_TELEVT_MODE,
+    ACTION_JUMP_TIME,
     ACTION_SENTINEL
 }  KeybindingAction;
 
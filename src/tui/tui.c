@@ -38,6 +38,7 @@
 #include "setting.h"
 #include "tui.h"
 #include "capture/capture.h"
+#include "storage/storage.h"
 #include "tui/windows/auth_validate_win.h"
 #include "tui/windows/call_list_win.h"
 #include "tui/windows/call_flow_win.h"
@@ -61,6 +62,11 @@
  */
 static GPtrArray *windows;
 
+//! Stored calls lock depth held by the interface
+static guint storage_holds = 0;
+//! Stored calls lock depth released while waiting for user input
+static guint storage_released = 0;
+
 GQuark
 tui_error_quark()
 {
@@ -170,6 +176,50 @@ tui_find_by_type(WindowType type)
     return window;
 }
 
+/**
+ * @brief Lock stored calls from the interface thread
+ *
+ * Lock depth is tracked so blocking dialogs can release it while waiting
+ * for user input.
+ */
+static void
+tui_storage_lock()
+{
+    storage_lock();
+    storage_holds++;
+}
+
+/**
+ * @brief Unlock stored calls from the interface thread
+ */
+static void
+tui_storage_unlock()
+{
+    storage_holds--;
+    storage_unlock();
+}
+
+void
+tui_input_wait_begin()
+{
+    g_return_if_fail(storage_released == 0);
+
+    // Let storage keep processing packets while user decides
+    storage_released = storage_holds;
+    for (guint i = 0; i < storage_released; i++) {
+        tui_storage_unlock();
+    }
+}
+
+void
+tui_input_wait_end()
+{
+    for (guint i = 0; i < storage_released; i++) {
+        tui_storage_lock();
+    }
+    storage_released = 0;
+}
+
 static gboolean
 tui_refresh_screen(GMainLoop *loop)
 {
@@ -181,15 +231,31 @@ tui_refresh_screen(GMainLoop *loop)
         // Get panel interface structure
         Window *ui = tui_find_by_panel(panel);
 
+        // Stored calls can not change while they are being checked
+        tui_storage_lock();
+
         // Query the interface if it needs to be redrawn
         if (window_redraw(ui)) {
+            // Panels with their own copy of stored calls are drawn unlocked
+            gboolean copied = window_update(ui);
+            if (copied)
+                tui_storage_unlock();
+
             // Redraw this panel
-            if (window_draw(ui) != 0) {
+            gint drawn = window_draw(ui);
+
+            if (copied)
+                tui_storage_lock();
+
+            if (drawn != 0) {
                 tui_destroy_window(ui);
+                tui_storage_unlock();
                 return TRUE;
             }
         }
 
+        tui_storage_unlock();
+
         // Update panel stack
         update_panels();
         doupdate();
@@ -224,6 +290,9 @@ tui_read_input(G_GNUC_UNUSED gint fd,
     if (c == ERR)
         return TRUE;
 
+    // Stored calls can not change while handling the key
+    tui_storage_lock();
+
     // Handle received key
     int hld = KEY_NOT_HANDLED;
     while (hld != KEY_HANDLED) {
@@ -247,6 +316,8 @@ tui_read_input(G_GNUC_UNUSED gint fd,
         }
     }
 
+    tui_storage_unlock();
+
     // Force screen redraw with each keystroke
     tui_refresh_screen(loop);
     return TRUE;
@@ -342,7 +413,8 @@ int
 draw_message_pos(WINDOW *win, Message *msg, int starting)
 {
     int height, width, line, column;
-    const char *cur_line, *payload, *method = NULL;
+    const char *cur_line, *method = NULL;
+    g_autofree gchar *payload = NULL;
     int syntax = setting_enabled(SETTING_TUI_SYNTAX);
     const char *nonascii = setting_get_value(SETTING_TUI_CR_NON_ASCII);
 
@@ -360,7 +432,7 @@ draw_message_pos(WINDOW *win, Message *msg, int starting)
     }
 
     // Get packet payload
-    cur_line = payload = msg_get_payload(msg);
+    cur_line = payload = msg_get_payload_str(msg);
 
     // Print msg payload
     line = starting;
@@ -115,6 +115,22 @@ tui_is_enabled();
 Window *
 tui_create_window(WindowType type);
 
+/**
+ * @brief Release stored calls lock while waiting for user input
+ *
+ * Blocking dialogs call this before waiting for keys so storage keeps
+ * processing packets. Stored calls can not be accessed until
+ * tui_input_wait_end is called.
+ */
+void
+tui_input_wait_begin();
+
+/**
+ * @brief Take back stored calls lock after waiting for user input
+ */
+void
+tui_input_wait_end();
+
 /**
  * @brief Find a ui from its panel pointer
  */
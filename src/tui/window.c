@@ -161,6 +161,20 @@ window_redraw(Window *window)
     return TRUE;
 }
 
+gboolean
+window_update(Window *window)
+{
+    g_return_val_if_fail(TUI_IS_WINDOW(window), FALSE);
+
+    WindowClass *klass = TUI_WINDOW_GET_CLASS(window);
+    if (klass->update != NULL) {
+        klass->update(window);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 int
 window_draw(Window *window)
 {
@@ -83,6 +83,8 @@ struct _WindowClass
     GObjectClass parent;
     //! Query the panel if redraw is required
     gboolean (*redraw)(Window *self);
+    //! Copy the stored calls data required to draw the panel
+    void (*update)(Window *self);
     //! Request the panel to redraw its data
     gint (*draw)(Window *self);
     //! Notifies the panel the screen has changed
@@ -144,6 +146,18 @@ window_resize(Window *window);
 gboolean
 window_redraw(Window *window);
 
+/**
+ * @brief Copy the stored data required to draw the panel
+ *
+ * This function acts as wrapper to custom ui update function.
+ * It must be called while holding the storage lock.
+ *
+ * @param window UI structure
+ * @return true if the panel can be drawn without storage lock, false otherwise
+ */
+gboolean
+window_update(Window *window);
+
 /**
  * @brief Notifies current ui the screen size has changed
  *
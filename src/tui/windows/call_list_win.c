@@ -32,6 +32,7 @@
 #include "glib-extra/glib.h"
 #include "setting.h"
 #include "storage/filter.h"
+#include "storage/datetime.h"
 #ifdef USE_HEP
 #include "capture/capture_hep.h"
 #endif
@@ -46,6 +47,31 @@
 
 G_DEFINE_TYPE(CallListWindow, call_list, TUI_TYPE_WINDOW)
 
+/**
+ * @brief Get the number of calls displayed in the list
+ */
+static gint
+call_list_displayed_count()
+{
+    return g_sequence_get_length(storage_calls_displayed());
+}
+
+/**
+ * @brief Get the displayed call at the given list position
+ *
+ * @param idx Position in the displayed calls list
+ * @return call at given position or NULL
+ */
+static Call *
+call_list_displayed_call(gint idx)
+{
+    GSequence *dcalls = storage_calls_displayed();
+    if (idx < 0 || idx >= g_sequence_get_length(dcalls))
+        return NULL;
+
+    return g_sequence_get(g_sequence_get_iter_at_pos(dcalls, idx));
+}
+
 /**
  * @brief Move selection cursor N times vertically
  *
@@ -59,7 +85,7 @@ call_list_move_vertical(CallListWindow *self, gint times)
     self->cur_idx = CLAMP(
         self->cur_idx + times,
         0,
-        (gint) g_ptr_array_len(self->dcalls) - 1
+        call_list_displayed_count() - 1
     );
 
     // Move the first index if required (moving up)
@@ -97,6 +123,40 @@ call_list_move_horizontal(CallListWindow *self, gint times)
     );
 }
 
+/**
+ * @brief Move selection cursor to the first call started at a given time
+ *
+ * When no date is given, the date of the selected call is used.
+ *
+ * @param self CallListWindow pointer
+ */
+static void
+call_list_jump_time(CallListWindow *self)
+{
+    // Selected call date is used as reference
+    Call *call = call_list_displayed_call(self->cur_idx);
+    if (call == NULL)
+        return;
+
+    // Stored calls can change while the dialog waits for input
+    guint64 ref = call->start_time;
+    g_autofree gchar *text = dialog_input("Jump to time", "Time ([yyyy/mm/dd] HH:MM[:SS]):");
+    if (text == NULL)
+        return;
+
+    guint64 ts = date_time_from_str(text, ref);
+    if (ts == 0) {
+        dialog_run("Invalid time: %s", text);
+        return;
+    }
+
+    // Find first displayed call started at or after requested time
+    if ((call = storage_calls_find_time(ts, TRUE)) == NULL)
+        return;
+
+    call_list_move_vertical(self, g_sequence_iter_get_position(call->display_iter) - self->cur_idx);
+}
+
 /**
  * @brief Determine if the screen requires redrawn
  *
@@ -111,6 +171,45 @@ call_list_redraw(G_GNUC_UNUSED Window *window)
     return storage_calls_changed();
 }
 
+/**
+ * @brief Copy displayed calls values required to draw the list
+ *
+ * Only the calls in visible rows are copied, so the list can be drawn
+ * while storage keeps processing packets.
+ *
+ * @param window UI structure pointer
+ */
+static void
+call_list_update(Window *window)
+{
+    CallListWindow *self = TUI_CALL_LIST(window);
+
+    // If autoscroll is enabled, select the last dialog
+    if (self->autoscroll) {
+        gint dcount = call_list_displayed_count();
+        StorageSortOpts sort = storage_sort_options();
+        if (sort.asc) {
+            call_list_move_vertical(self, dcount);
+        } else {
+            call_list_move_vertical(self, dcount * -1);
+        }
+    }
+
+    g_autoptr(GPtrArray) attributes = g_ptr_array_new();
+    for (guint i = 0; i < g_ptr_array_len(self->columns); i++) {
+        CallListColumn *column = g_ptr_array_index(self->columns, i);
+        g_ptr_array_add(attributes, column->attr);
+    }
+
+    // Copy one call for each list row (excluding the header line)
+    g_clear_pointer(&self->snapshot, storage_snapshot_free);
+    self->snapshot = storage_calls_snapshot(
+        (guint) self->vscroll.pos,
+        (guint) MAX(getmaxy(self->list_win) - 1, 0),
+        attributes
+    );
+}
+
 /**
  * @brief Resize the windows of Call List
  *
@@ -211,7 +310,7 @@ call_list_draw_header(CallListWindow *self)
     }
 
     // Print calls count (also filtered)
-    StorageStats stats = storage_calls_stats();
+    StorageStats stats = self->snapshot->stats;
     if (stats.total != stats.displayed) {
         mvwprintw(win, 1, 33, "%s: %d (%d displayed)", countlb, stats.total, stats.displayed);
     } else {
@@ -220,7 +319,7 @@ call_list_draw_header(CallListWindow *self)
 
     if (storage_memory_limit() > 0) {
         g_autofree const gchar *usage = g_format_size_full(
-            storage_memory_usage(),
+            self->snapshot->memory_usage,
             G_FORMAT_SIZE_IEC_UNITS
         );
         g_autofree const gchar *limit = g_format_size_full(
@@ -331,19 +430,9 @@ call_list_draw_list(CallListWindow *self)
     WINDOW *list_win = self->list_win;
     getmaxyx(list_win, listh, listw);
 
-    // Get the list of calls that are going to be displayed
-    g_ptr_array_free(self->dcalls, TRUE);
-    self->dcalls = g_ptr_array_copy_filtered(storage_calls(), (GEqualFunc) filter_check_call, NULL);
-
-    // If autoscroll is enabled, select the last dialog
-    if (self->autoscroll) {
-        StorageSortOpts sort = storage_sort_options();
-        if (sort.asc) {
-            call_list_move_vertical(self, g_ptr_array_len(self->dcalls));
-        } else {
-            call_list_move_vertical(self, g_ptr_array_len(self->dcalls) * -1);
-        }
-    }
+    // Get the copy of calls that are going to be displayed
+    StorageSnapshot *snapshot = self->snapshot;
+    gint dcount = (gint) snapshot->stats.displayed;
 
     // Clear call list before redrawing
     werase(list_win);
@@ -381,15 +470,12 @@ call_list_draw_list(CallListWindow *self)
     }
     wattroff(pad, A_BOLD | COLOR_PAIR(CP_DEF_ON_CYAN));
 
-    // Fill the call list
+    // Fill the call list (only visible rows are copied)
     cline = 1;
-    for (guint i = (guint) self->vscroll.pos; i < g_ptr_array_len(self->dcalls); i++) {
-        Call *call = g_ptr_array_index(self->dcalls, i);
-        g_return_if_fail(call != NULL);
-
-        // Get first call message attributes
-        Message *msg = g_ptr_array_first(call->msgs);
-        g_return_if_fail(msg != NULL);
+    for (guint row = 0; row < g_ptr_array_len(snapshot->calls); row++) {
+        StorageSnapshotCall *scall = g_ptr_array_index(snapshot->calls, row);
+        Call *call = scall->call;
+        gint i = (gint) (snapshot->offset + row);
 
         // Stop if we have reached the bottom of the list
         if (cline == listh)
@@ -400,7 +486,7 @@ call_list_draw_list(CallListWindow *self)
             wattron(pad, A_BOLD | COLOR_PAIR(CP_DEFAULT));
 
         // Highlight active call
-        if (self->cur_idx == (gint) i) {
+        if (self->cur_idx == i) {
             wattron(pad, COLOR_PAIR(CP_WHITE_ON_BLUE));
         }
 
@@ -416,14 +502,14 @@ call_list_draw_list(CallListWindow *self)
 
             // Get call attribute for current column
             const gchar *coltext = NULL;
-            if ((coltext = msg_get_attribute(msg, column->attr)) == NULL) {
+            if ((coltext = g_ptr_array_index(scall->values, j)) == NULL) {
                 colpos += column->width + 1;
                 continue;
             }
 
             // Enable attribute color (if not current one)
             color = 0;
-            if (self->cur_idx != (gint) i) {
+            if (self->cur_idx != i) {
                 if ((color = attribute_get_color(column->attr, coltext)) > 0) {
                     wattron(pad, color);
                 }
@@ -457,7 +543,7 @@ call_list_draw_list(CallListWindow *self)
     self->hscroll.preoffset = 1;    // Leave first column for vscroll
 
     // Setup vertical scrollbar
-    self->vscroll.max = g_ptr_array_len(self->dcalls) - 1;
+    self->vscroll.max = dcount - 1;
     self->vscroll.preoffset = 1;    // Leave first row for titles
     if (scrollbar_visible(self->hscroll)) {
         self->vscroll.postoffset = 1; // Leave last row for hscroll
@@ -549,39 +635,17 @@ call_list_form_activate(CallListWindow *self, gboolean active)
     form_driver(self->form, REQ_END_LINE);
 }
 
-/**
- * @brief Get List line from the given call
- *
- * Get the list line of the given call to display in the list
- * This line is built using the configured columns and sizes
- *
- * @param window UI structure pointer
- * @param call Call to get data from
- * @param text Text pointer to store the generated line
- * @return A pointer to text
- */
-const char *
-call_list_win_line_text(Window *window, Call *call)
+void
+call_list_win_filter_columns(GPtrArray *columns)
 {
-    CallListWindow *self = TUI_CALL_LIST(window);
-
-    // Get first call message
-    Message *msg = g_ptr_array_first(call->msgs);
-    g_return_val_if_fail(msg != NULL, NULL);
-
-    // Print requested columns
-    GString *out = g_string_new(NULL);
-    for (guint i = 0; i < g_ptr_array_len(self->columns); i++) {
-        CallListColumn *column = g_ptr_array_index(self->columns, i);
-
-        // Get call attribute for current column
-        const gchar *call_attr = NULL;
-        if ((call_attr = msg_get_attribute(msg, column->attr)) != NULL) {
-            g_string_append(out, call_attr);
-        }
+    g_autoptr(GPtrArray) attributes = g_ptr_array_new();
+    for (guint i = 0; i < g_ptr_array_len(columns); i++) {
+        CallListColumn *column = g_ptr_array_index(columns, i);
+        g_ptr_array_add(attributes, column->attr);
     }
 
-    return out->str;
+    // Storage checks the filter against a copy of current columns
+    filter_set_line_attributes(attributes);
 }
 
 /**
@@ -699,15 +763,6 @@ call_list_handle_form_key(CallListWindow *self, int key)
         break;
     }
 
-    // Filter has changed, re-apply filter to displayed calls
-    if (action == ACTION_PRINTABLE || action == ACTION_BACKSPACE ||
-        action == ACTION_DELETE || action == ACTION_CLEAR) {
-        // Updated displayed results
-        call_list_win_clear(TUI_WINDOW(self));
-        // Reset filters on each key stroke
-        filter_reset_calls();
-    }
-
     // Validate all input data
     form_driver(self->form, REQ_VALIDATION);
 
@@ -718,9 +773,19 @@ call_list_handle_form_key(CallListWindow *self, int key)
     g_strstrip(dfilter);    // Trim any trailing spaces
 
     // Set display filter
+    call_list_win_filter_columns(self->columns);
     filter_set(FILTER_CALL_LIST, strlen(dfilter) ? dfilter : NULL);
     g_free(dfilter);
 
+    // Filter has changed, re-apply filter to displayed calls
+    if (action == ACTION_PRINTABLE || action == ACTION_BACKSPACE ||
+        action == ACTION_DELETE || action == ACTION_CLEAR) {
+        // Updated displayed results
+        call_list_win_clear(TUI_WINDOW(self));
+        // Reset filters on each key stroke
+        filter_reset_calls();
+    }
+
     // Return if this panel has handled or not the key
     return (action == ERR) ? KEY_NOT_HANDLED : KEY_HANDLED;
 }
@@ -867,20 +932,23 @@ call_list_handle_key(Window *window, int key)
                 call_list_move_vertical(self, -1 * rnpag_steps);
                 break;
             case ACTION_BEGIN:
-                call_list_move_vertical(self, g_ptr_array_len(self->dcalls) * -1);
+                call_list_move_vertical(self, call_list_displayed_count() * -1);
                 break;
             case ACTION_END:
-                call_list_move_vertical(self, g_ptr_array_len(self->dcalls));
+                call_list_move_vertical(self, call_list_displayed_count());
                 break;
             case ACTION_DISP_FILTER:
                 // Activate Form
                 call_list_form_activate(self, 1);
                 break;
+            case ACTION_JUMP_TIME:
+                call_list_jump_time(self);
+                break;
             case ACTION_SHOW_FLOW:
             case ACTION_SHOW_FLOW_EX:
             case ACTION_SHOW_RAW:
                 // Check we have calls in the list
-                if (g_ptr_array_empty(self->dcalls))
+                if ((call = call_list_displayed_call(self->cur_idx)) == NULL)
                     break;
 
                 // Create a new group of calls
@@ -888,11 +956,10 @@ call_list_handle_key(Window *window, int key)
 
                 // If not selected call, show current call flow
                 if (call_group_count(group) == 0)
-                    call_group_add(group, g_ptr_array_index(self->dcalls, self->cur_idx));
+                    call_group_add(group, call);
 
                 // Add xcall to the group
                 if (action == ACTION_SHOW_FLOW_EX) {
-                    call = g_ptr_array_index(self->dcalls, self->cur_idx);
                     call_group_add_calls(group, call->xcalls);
                     group->callid = call->callid;
                 }
@@ -944,11 +1011,10 @@ call_list_handle_key(Window *window, int key)
                 break;
             case ACTION_SELECT:
                 // Ignore on empty list
-                if (g_ptr_array_len(self->dcalls) == 0) {
+                if ((call = call_list_displayed_call(self->cur_idx)) == NULL) {
                     break;
                 }
 
-                call = g_ptr_array_index(self->dcalls, self->cur_idx);
                 if (call_group_exists(self->group, call)) {
                     call_group_remove(self->group, call);
                 } else {
@@ -995,6 +1061,7 @@ call_list_handle_key(Window *window, int key)
         case ACTION_BEGIN:
         case ACTION_END:
         case ACTION_DISP_FILTER:
+        case ACTION_JUMP_TIME:
             self->autoscroll = 0;
             break;
         default:
@@ -1069,6 +1136,7 @@ call_list_help(G_GNUC_UNUSED Window *window)
     mvwprintw(help_win, 21, 2, "F10/t       Select displayed columns");
     mvwprintw(help_win, 22, 2, "i/I         Set display filter to invite");
     mvwprintw(help_win, 23, 2, "p           Stop/Resume packet capture");
+    mvwprintw(help_win, 24, 2, "g           Jump to first call started at given time");
 
     // Press any key to close
     wgetch(help_win);
@@ -1144,9 +1212,9 @@ call_list_finalize(GObject *object)
     }
 
     // Deallocate window private data
+    g_clear_pointer(&self->snapshot, storage_snapshot_free);
     call_group_free(self->group);
     g_ptr_array_free(self->columns, TRUE);
-    g_ptr_array_free(self->dcalls, TRUE);
     delwin(self->list_win);
 
     // Chain-up parent finalize function
@@ -1220,6 +1288,7 @@ call_list_constructed(GObject *object)
     // Apply initial configured filters
     filter_method_from_setting(setting_get_value(SETTING_STORAGE_FILTER_METHODS));
     filter_payload_from_setting(setting_get_value(SETTING_STORAGE_FILTER_PAYLOAD));
+    filter_reset_calls();
 }
 
 static void
@@ -1231,6 +1300,7 @@ call_list_class_init(CallListWindowClass *klass)
 
     WindowClass *window_class = TUI_WINDOW_CLASS(klass);
     window_class->redraw = call_list_redraw;
+    window_class->update = call_list_update;
     window_class->draw = call_list_draw;
     window_class->resize = call_list_resize;
     window_class->handle_key = call_list_handle_key;
@@ -1245,5 +1315,4 @@ call_list_init(G_GNUC_UNUSED CallListWindow *self)
 
     // Initialize Call List attributes
     self->group = call_group_new();
-    self->dcalls = g_ptr_array_new();
 }
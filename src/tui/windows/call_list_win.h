@@ -89,8 +89,6 @@ struct _CallListWindow
 {
     //! Parent object attributes
     Window parent;
-    //! Displayed calls vector
-    GPtrArray *dcalls;
     //! Selected call in the list
     gint cur_idx;
     //! First displayed call in the list
@@ -121,6 +119,8 @@ struct _CallListWindow
     Scrollbar vscroll;
     //! List horizontal scrollbar
     Scrollbar hscroll;
+    //! Copy of displayed calls values being drawn
+    StorageSnapshot *snapshot;
 };
 
 /**
@@ -138,18 +138,15 @@ Window *
 call_list_win_new();
 
 /**
- * @brief Get List line from the given call
+ * @brief Set the columns used by the call list line filter
  *
- * Get the list line of the given call to display in the list
- * This line is built using the configured columns and sizes
+ * Call list filter is checked against the text of these columns, so this
+ * must be called each time the displayed columns change.
  *
- * @param window UI structure pointer
- * @param call Call to get data from
- * @param text Text pointer to store the generated line
- * @return A pointer to text
+ * @param columns Array of call list columns (CallListColumn *)
  */
-const char *
-call_list_win_line_text(Window *window, Call *call);
+void
+call_list_win_filter_columns(GPtrArray *columns);
 
 /**
  * @brief Remove all calls from the list and calls storage
@@ -91,7 +91,7 @@ call_raw_win_print_msg(Window *window, Message *msg)
     getmaxyx(pad, height, width);
 
     // Get message payload
-    g_autofree gchar *payload = msg_get_payload(msg);
+    g_autofree gchar *payload = msg_get_payload_str(msg);
 
     // Check how many lines we well need to draw this message
     payload_lines = 0;
@@ -32,6 +32,7 @@
 #include <errno.h>
 #include <glib/gstdio.h>
 #include "glib-extra/glib.h"
+#include "storage/filter.h"
 #include "tui/tui.h"
 #include "tui/dialog.h"
 #include "tui/windows/call_list_win.h"
@@ -152,6 +153,12 @@ column_select_update_columns(ColumnSelectWindow *self)
         column->width = attribute_get_length(attr);
         g_ptr_array_add(self->selected, column);
     }
+
+    // Call list filter text depends on displayed columns
+    call_list_win_filter_columns(self->selected);
+    if (filter_get(FILTER_CALL_LIST) != NULL) {
+        filter_reset_calls();
+    }
 }
 
 /**
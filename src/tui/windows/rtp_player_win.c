@@ -95,9 +95,9 @@ rtp_player_win_draw(Window *window)
 
     mvwprintw(win, 6, 50, "Latency: %d ms", self->latency / 1000);
 
-    if (self->stream->changed) {
+    if (self->stream->packet_count != self->last_packet) {
         rtp_player_win_decode_stream(window, self->stream);
-        self->stream->changed = FALSE;
+        self->last_packet = self->stream->packet_count;
     }
 
     if (self->decoded->len == 0) {
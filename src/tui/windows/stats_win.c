@@ -69,7 +69,7 @@ stats_win_new()
 {
     return g_object_new(
         WINDOW_TYPE_STATS,
-        "height", 25,
+        "height", 30,
         "width", 60,
         NULL
     );
@@ -81,16 +81,6 @@ stats_constructed(GObject *object)
     // Chain-up parent constructed
     G_OBJECT_CLASS(stats_parent_class)->constructed(object);
 
-    // Counters!
-    struct
-    {
-        gint dtotal, dcalls, completed, cancelled, incall, rejected, setup, busy, diverted;
-        gint mtotal, invite, regist, subscribe, update, notify, options;
-        gint publish, message, info, ack, bye, cancel;
-        gint r100, r200, r300, r400, r500, r600, r700, r800;
-    } stats;
-    memset(&stats, 0, sizeof(stats));
-
     // Get parent window information
     StatsWindow *self = TUI_STATS(object);
     Window *parent = TUI_WINDOW(self);
@@ -111,152 +101,106 @@ stats_constructed(GObject *object)
     mvwprintw(win, height - 2, width / 2 - 9, "Press ESC to leave");
     wattroff(win, COLOR_PAIR(CP_BLUE_ON_DEF));
 
-    // Parse the data
-    GPtrArray *calls = storage_calls();
-    stats.dtotal = g_ptr_array_len(calls);
+    // Get storage counters
+    StorageStats stats = storage_calls_stats();
 
     // Ignore this screen when no dialog exists
-    if (!stats.dtotal) {
+    if (!stats.total) {
         mvwprintw(win, 3, 3, "No information to display");
         return;
     }
 
-    for (guint i = 0; i < g_ptr_array_len(calls); i++) {
-        Call *call = g_ptr_array_index(calls, i);
+    // Dialogs that are not calls have no state
+    guint dcalls = stats.total - stats.states[0];
 
-        // If this dialog is a call
-        if (call->state) {
-            // Increase call counter
-            stats.dcalls++;
-            // Increase call status counter
-            switch (call->state) {
-                case CALL_STATE_CALLSETUP:
-                    stats.setup++;
-                    break;
-                case CALL_STATE_INCALL:
-                    stats.incall++;
-                    break;
-                case CALL_STATE_CANCELLED:
-                    stats.cancelled++;
-                    break;
-                case CALL_STATE_REJECTED:
-                    stats.rejected++;
-                    break;
-                case CALL_STATE_BUSY:
-                    stats.busy++;
-                    break;
-                case CALL_STATE_DIVERTED:
-                    stats.diverted++;
-                    break;
-                case CALL_STATE_COMPLETED:
-                    stats.completed++;
-                    break;
-            }
+    // Print parses data
+    mvwprintw(win, 3, 3, "Dialogs: %d", stats.total);
+    mvwprintw(win, 4, 3, "Calls: %d (%.1f%%)", dcalls, (float) dcalls * 100 / stats.total);
+    mvwprintw(win, 5, 3, "Messages: %d", stats.msgs);
+    // Print status of calls if any
+    if (dcalls) {
+        const struct
+        {
+            enum CallState state;
+            const gchar *label;
+        } states[] = {
+            { CALL_STATE_COMPLETED, "COMPLETED:" },
+            { CALL_STATE_CANCELLED, "CANCELLED:" },
+            { CALL_STATE_INCALL, "IN CALL:" },
+            { CALL_STATE_REJECTED, "REJECTED:" },
+            { CALL_STATE_BUSY, "BUSY:" },
+            { CALL_STATE_DIVERTED, "DIVERTED:" },
+            { CALL_STATE_CALLSETUP, "CALL SETUP:" },
+        };
+
+        for (guint i = 0; i < G_N_ELEMENTS(states); i++) {
+            guint count = stats.states[states[i].state];
+            mvwprintw(win, 3 + i, 33, "%-11s %d (%.1f%%)", states[i].label, count,
+                      (float) count * 100 / dcalls);
         }
+    }
 
-        // For each message in call
-        for (guint i = 0; i < g_ptr_array_len(call->msgs); i++) {
-            Message *msg = g_ptr_array_index(call->msgs, i);
-            guint method = msg_get_method(msg);
+    const struct
+    {
+        enum SipMethods method;
+        const gchar *label;
+    } methods[] = {
+        { SIP_METHOD_INVITE, "INVITE:" },
+        { SIP_METHOD_REGISTER, "REGISTER:" },
+        { SIP_METHOD_SUBSCRIBE, "SUBSCRIBE:" },
+        { SIP_METHOD_UPDATE, "UPDATE:" },
+        { SIP_METHOD_NOTIFY, "NOTIFY:" },
+        { SIP_METHOD_OPTIONS, "OPTIONS:" },
+        { SIP_METHOD_PUBLISH, "PUBLISH:" },
+        { SIP_METHOD_MESSAGE, "MESSAGE:" },
+        { SIP_METHOD_INFO, "INFO:" },
+        { SIP_METHOD_BYE, "BYE:" },
+        { SIP_METHOD_CANCEL, "CANCEL:" },
+    };
+
+    for (guint i = 0; i < G_N_ELEMENTS(methods); i++) {
+        guint count = stats.methods[methods[i].method];
+        mvwprintw(win, 11 + i, 3, "%-10s %d (%.1f%%)", methods[i].label, count,
+                  (float) count * 100 / stats.msgs);
+    }
 
-            // Increase message counter
-            stats.mtotal++;
-            // Check message type
-            switch (method) {
-                case SIP_METHOD_REGISTER:
-                    stats.regist++;
-                    break;
-                case SIP_METHOD_INVITE:
-                    stats.invite++;
-                    break;
-                case SIP_METHOD_SUBSCRIBE:
-                    stats.subscribe++;
-                    break;
-                case SIP_METHOD_NOTIFY:
-                    stats.notify++;
-                    break;
-                case SIP_METHOD_OPTIONS:
-                    stats.options++;
-                    break;
-                case SIP_METHOD_PUBLISH:
-                    stats.publish++;
-                    break;
-                case SIP_METHOD_MESSAGE:
-                    stats.message++;
-                    break;
-                case SIP_METHOD_CANCEL:
-                    stats.cancel++;
-                    break;
-                case SIP_METHOD_BYE:
-                    stats.bye++;
-                    break;
-                case SIP_METHOD_ACK:
-                    stats.ack++;
-                    break;
-                    // case SIP_METHOD_PRACK:
-                case SIP_METHOD_INFO:
-                    stats.info++;
-                    break;
-                    // case SIP_METHOD_REFER:
-                case SIP_METHOD_UPDATE:
-                    stats.update++;
-                    break;
-                default:
-                    if (method >= 800) stats.r800++;
-                    else if (method >= 700) stats.r700++;
-                    else if (method >= 600) stats.r600++;
-                    else if (method >= 500) stats.r500++;
-                    else if (method >= 400) stats.r400++;
-                    else if (method >= 300) stats.r300++;
-                    else if (method >= 200) stats.r200++;
-                    else if (method >= 100) stats.r100++;
-            }
-        }
+    for (guint i = 1; i < STORAGE_STATS_RESPONSES; i++) {
+        guint count = stats.responses[i];
+        mvwprintw(win, 10 + i, 33, "%dXX: %d (%.1f%%)", i, count, (float) count * 100 / stats.msgs);
+    }
 
+    // Print memory usage of each storage subsystem
+    wattron(win, COLOR_PAIR(CP_BLUE_ON_DEF));
+    mvwhline(win, 23, 1, ACS_HLINE, width - 1);
+    mvwaddch(win, 23, 0, ACS_LTEE);
+    mvwaddch(win, 23, width - 1, ACS_RTEE);
+    wattroff(win, COLOR_PAIR(CP_BLUE_ON_DEF));
 
-    }
+    const gchar *memory_labels[STORAGE_MEMORY_COUNT] = {
+        [STORAGE_MEMORY_PACKETS] = "Packets:",
+        [STORAGE_MEMORY_CALLS] = "Dialogs:",
+        [STORAGE_MEMORY_REASSEMBLY] = "Reassembly:",
+    };
 
-    // Print parses data
-    mvwprintw(win, 3, 3, "Dialogs: %d", stats.dtotal);
-    mvwprintw(win, 4, 3, "Calls: %d (%.1f%%)", stats.dcalls, (float) stats.dcalls * 100 / stats.dtotal);
-    mvwprintw(win, 5, 3, "Messages: %d", stats.mtotal);
-    // Print status of calls if any
-    if (stats.dcalls) {
-        mvwprintw(win, 3, 33, "COMPLETED:  %d (%.1f%%)", stats.completed,
-                  (float) stats.completed * 100 / stats.dcalls);
-        mvwprintw(win, 4, 33, "CANCELLED:  %d (%.1f%%)", stats.cancelled,
-                  (float) stats.cancelled * 100 / stats.dcalls);
-        mvwprintw(win, 5, 33, "IN CALL:    %d (%.1f%%)", stats.incall,
-                  (float) stats.incall * 100 / stats.dcalls);
-        mvwprintw(win, 6, 33, "REJECTED:   %d (%.1f%%)", stats.rejected,
-                  (float) stats.rejected * 100 / stats.dcalls);
-        mvwprintw(win, 7, 33, "BUSY:       %d (%.1f%%)", stats.busy, (float) stats.busy * 100 / stats.dcalls);
-        mvwprintw(win, 8, 33, "DIVERTED:   %d (%.1f%%)", stats.diverted,
-                  (float) stats.diverted * 100 / stats.dcalls);
-        mvwprintw(win, 9, 33, "CALL SETUP: %d (%.1f%%)", stats.setup, (float) stats.setup * 100 / stats.dcalls);
+    for (guint i = 0; i < STORAGE_MEMORY_COUNT; i++) {
+        g_autofree gchar *usage = g_format_size_full(storage_memory_usage_by_type(i), G_FORMAT_SIZE_IEC_UNITS);
+        mvwprintw(win, 24 + i / 2, 3 + (i % 2) * 30, "%-11s %s", memory_labels[i], usage);
     }
 
-    mvwprintw(win, 11, 3, "INVITE:    %d (%.1f%%)", stats.invite, (float) stats.invite * 100 / stats.mtotal);
-    mvwprintw(win, 12, 3, "REGISTER:  %d (%.1f%%)", stats.regist, (float) stats.regist * 100 / stats.mtotal);
-    mvwprintw(win, 13, 3, "SUBSCRIBE: %d (%.1f%%)", stats.subscribe,
-              (float) stats.subscribe * 100 / stats.mtotal);
-    mvwprintw(win, 14, 3, "UPDATE:    %d (%.1f%%)", stats.update, (float) stats.update * 100 / stats.mtotal);
-    mvwprintw(win, 15, 3, "NOTIFY:    %d (%.1f%%)", stats.notify, (float) stats.notify * 100 / stats.mtotal);
-    mvwprintw(win, 16, 3, "OPTIONS:   %d (%.1f%%)", stats.options, (float) stats.options * 100 / stats.mtotal);
-    mvwprintw(win, 17, 3, "PUBLISH:   %d (%.1f%%)", stats.publish, (float) stats.publish * 100 / stats.mtotal);
-    mvwprintw(win, 18, 3, "MESSAGE:   %d (%.1f%%)", stats.message, (float) stats.message * 100 / stats.mtotal);
-    mvwprintw(win, 19, 3, "INFO:      %d (%.1f%%)", stats.info, (float) stats.info * 100 / stats.mtotal);
-    mvwprintw(win, 20, 3, "BYE:       %d (%.1f%%)", stats.bye, (float) stats.bye * 100 / stats.mtotal);
-    mvwprintw(win, 21, 3, "CANCEL:    %d (%.1f%%)", stats.cancel, (float) stats.cancel * 100 / stats.mtotal);
+    g_autofree gchar *total = g_format_size_full(storage_memory_usage(), G_FORMAT_SIZE_IEC_UNITS);
+    if (storage_memory_limit() > 0) {
+        g_autofree gchar *limit = g_format_size_full(storage_memory_limit(), G_FORMAT_SIZE_IEC_UNITS);
+        mvwprintw(win, 26, 3, "%-11s %s / %s", "Memory:", total, limit);
+    } else {
+        mvwprintw(win, 26, 3, "%-11s %s", "Memory:", total);
+    }
 
-    mvwprintw(win, 11, 33, "1XX: %d (%.1f%%)", stats.r100, (float) stats.r100 * 100 / stats.mtotal);
-    mvwprintw(win, 12, 33, "2XX: %d (%.1f%%)", stats.r200, (float) stats.r200 * 100 / stats.mtotal);
-    mvwprintw(win, 13, 33, "3XX: %d (%.1f%%)", stats.r300, (float) stats.r300 * 100 / stats.mtotal);
-    mvwprintw(win, 14, 33, "4XX: %d (%.1f%%)", stats.r400, (float) stats.r400 * 100 / stats.mtotal);
-    mvwprintw(win, 15, 33, "5XX: %d (%.1f%%)", stats.r500, (float) stats.r500 * 100 / stats.mtotal);
-    mvwprintw(win, 16, 33, "6XX: %d (%.1f%%)", stats.r600, (float) stats.r600 * 100 / stats.mtotal);
-    mvwprintw(win, 17, 33, "7XX: %d (%.1f%%)", stats.r700, (float) stats.r700 * 100 / stats.mtotal);
-    mvwprintw(win, 18, 33, "8XX: %d (%.1f%%)", stats.r800, (float) stats.r800 * 100 / stats.mtotal);
+    // Payload filters check all calls while payload index is not available
+    if (storage_payload_index_disabled()) {
+        wattron(win, COLOR_PAIR(CP_RED_ON_DEF));
+        mvwprintw(win, 27, 3, "Payload index disabled: memory limit reached");
+        wattroff(win, COLOR_PAIR(CP_RED_ON_DEF));
+    }
 
 }
 
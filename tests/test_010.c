@@ -0,0 +1,115 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_010.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for GBytes views
+ */
+
+#include <string.h>
+#include <glib.h>
+#include "glib-extra/gbytes.h"
+
+static void
+test_bytes_view_offset()
+{
+    g_autoptr(GBytes) bytes = g_bytes_new_static("0123456789", 10);
+    GBytesView view = g_bytes_view(bytes);
+    g_assert_true(view.bytes == bytes);
+    g_assert_cmpuint(g_bytes_view_get_size(view), ==, 10);
+
+    view = g_bytes_view_offset(view, 4);
+    g_assert_cmpuint(g_bytes_view_get_size(view), ==, 6);
+    g_assert_cmpint(memcmp(g_bytes_view_get_data(view), "456789", 6), ==, 0);
+
+    // Offsets are clamped to the view size
+    view = g_bytes_view_offset(view, 100);
+    g_assert_false(g_bytes_view_is_none(view));
+    g_assert_cmpuint(g_bytes_view_get_size(view), ==, 0);
+}
+
+static void
+test_bytes_view_set_size()
+{
+    g_autoptr(GBytes) bytes = g_bytes_new_static("0123456789", 10);
+    GBytesView view = g_bytes_view_offset(g_bytes_view(bytes), 2);
+
+    view = g_bytes_view_set_size(view, 3);
+    g_assert_cmpuint(g_bytes_view_get_size(view), ==, 3);
+    g_assert_cmpint(memcmp(g_bytes_view_get_data(view), "234", 3), ==, 0);
+
+    // Views can not grow
+    view = g_bytes_view_set_size(view, 8);
+    g_assert_cmpuint(g_bytes_view_get_size(view), ==, 3);
+}
+
+static void
+test_bytes_view_to_bytes()
+{
+    g_autoptr(GBytes) bytes = g_bytes_new("0123456789", 10);
+
+    // Whole views share the viewed bytes
+    g_autoptr(GBytes) whole = g_bytes_view_to_bytes(g_bytes_view(bytes));
+    g_assert_true(whole == bytes);
+
+    // Partial views share the viewed memory
+    GBytesView view = g_bytes_view_set_size(g_bytes_view_offset(g_bytes_view(bytes), 5), 2);
+    g_autoptr(GBytes) part = g_bytes_view_to_bytes(view);
+    g_assert_cmpuint(g_bytes_get_size(part), ==, 2);
+    g_assert_true(g_bytes_get_data(part, NULL) == g_bytes_view_get_data(view));
+    g_assert_cmpint(memcmp(g_bytes_get_data(part, NULL), "56", 2), ==, 0);
+}
+
+static void
+test_bytes_view_ascii_casehash()
+{
+    g_autoptr(GBytes) upper = g_bytes_new_static("INVITE sip:alice@example.com", 28);
+    g_autoptr(GBytes) lower = g_bytes_new_static("invite SIP:ALICE@EXAMPLE.COM", 28);
+    g_autoptr(GBytes) other = g_bytes_new_static("invite sip:alice@example.org", 28);
+
+    guint64 hash = g_bytes_view_ascii_casehash(g_bytes_view(upper));
+    g_assert_cmpuint(hash, ==, g_bytes_view_ascii_casehash(g_bytes_view(lower)));
+    g_assert_cmpuint(hash, !=, g_bytes_view_ascii_casehash(g_bytes_view(other)));
+
+    // Hash only covers viewed data
+    GBytesView view = g_bytes_view_set_size(g_bytes_view(upper), 6);
+    GBytesView method = g_bytes_view_set_size(g_bytes_view(other), 6);
+    g_assert_cmpuint(g_bytes_view_ascii_casehash(view), ==, g_bytes_view_ascii_casehash(method));
+
+    // FNV-1a offset basis for empty data
+    g_assert_cmpuint(
+        g_bytes_view_ascii_casehash(g_bytes_view_offset(view, 6)), ==,
+        G_GUINT64_CONSTANT(0xcbf29ce484222325)
+    );
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/gbytes/view/offset", test_bytes_view_offset);
+    g_test_add_func("/gbytes/view/set_size", test_bytes_view_set_size);
+    g_test_add_func("/gbytes/view/to_bytes", test_bytes_view_to_bytes);
+    g_test_add_func("/gbytes/view/ascii_casehash", test_bytes_view_ascii_casehash);
+    return g_test_run();
+}
@@ -0,0 +1,121 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_011.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for match expression literal extraction
+ */
+
+#include <glib.h>
+#include "storage/storage.h"
+
+/**
+ * @brief Check the literal and exact flag extracted from an expression
+ */
+static void
+check_literal(const gchar *expr, gboolean icase, gboolean extended, const gchar *expected, gboolean expected_exact)
+{
+    gboolean exact = FALSE;
+    g_autofree gchar *literal = storage_match_literal(expr, icase, extended, &exact);
+    g_assert_cmpstr(literal, ==, expected);
+    if (expected != NULL) {
+        g_assert_cmpint(exact, ==, expected_exact);
+    }
+}
+
+static void
+test_match_literal_exact()
+{
+    check_literal("alice", FALSE, FALSE, "alice", TRUE);
+    check_literal("34911223344", FALSE, FALSE, "34911223344", TRUE);
+    check_literal("sip\\.example\\.com", FALSE, FALSE, "sip.example.com", TRUE);
+    check_literal("abc\\d+", FALSE, FALSE, "abc", FALSE);
+    check_literal("^INVITE", FALSE, FALSE, "INVITE", FALSE);
+    check_literal("abc.defgh", FALSE, FALSE, "defgh", FALSE);
+    check_literal("[0-9]defg", FALSE, FALSE, "defg", FALSE);
+    check_literal("(ab)cdef", FALSE, FALSE, "cdef", FALSE);
+}
+
+static void
+test_match_literal_quantifiers()
+{
+    // Optional characters are not part of the literal
+    check_literal("abcd?ef", FALSE, FALSE, "abc", FALSE);
+    check_literal("ab*cdef", FALSE, FALSE, "cdef", FALSE);
+    check_literal("abcde{0,}fg", FALSE, FALSE, "abcd", FALSE);
+    check_literal("abcde{0,3}fg", FALSE, FALSE, "abcd", FALSE);
+    // Required repeated characters end the literal
+    check_literal("abcd{2}e", FALSE, FALSE, "abcd", FALSE);
+    check_literal("abcd+e", FALSE, FALSE, "abcd", FALSE);
+    // Only optional characters
+    check_literal("a*", FALSE, FALSE, NULL, FALSE);
+    check_literal(".*", FALSE, FALSE, NULL, FALSE);
+}
+
+static void
+test_match_literal_unsupported()
+{
+    check_literal("alice|bob", FALSE, FALSE, NULL, FALSE);
+    check_literal("(?i)alice", FALSE, FALSE, NULL, FALSE);
+    check_literal("(a|b)cdef", FALSE, FALSE, NULL, FALSE);
+    check_literal("(a)\\1bcd", FALSE, FALSE, NULL, FALSE);
+    check_literal("abc{x}", FALSE, FALSE, NULL, FALSE);
+    check_literal("abc\\", FALSE, FALSE, NULL, FALSE);
+    check_literal("[abc", FALSE, FALSE, NULL, FALSE);
+}
+
+static void
+test_match_literal_extended()
+{
+    // Whitespace and comments are ignored in extended mode
+    check_literal("INVITE # initial requests", FALSE, TRUE, "INVITE", TRUE);
+    check_literal("ali ce", FALSE, TRUE, "alice", TRUE);
+    check_literal("abc # comment\ndefgh", FALSE, TRUE, "abcdefgh", TRUE);
+    check_literal("abc\\ def", FALSE, TRUE, "abc def", TRUE);
+    // And are literal characters otherwise
+    check_literal("INVITE # initial", FALSE, FALSE, "INVITE # initial", TRUE);
+}
+
+static void
+test_match_literal_caseless()
+{
+    check_literal("ALICE", TRUE, FALSE, "alice", TRUE);
+    // 'k' and 's' match unicode characters ignoring case
+    check_literal("Kamailio", TRUE, FALSE, "amailio", FALSE);
+    check_literal("SIP/2.0", TRUE, FALSE, "ip/2", FALSE);
+    check_literal("Kamailio", FALSE, FALSE, "Kamailio", TRUE);
+    // Non ASCII characters are not part of caseless literals
+    check_literal("caf\xc3\xa9 au lait", TRUE, FALSE, " au lait", FALSE);
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/storage/match_literal/exact", test_match_literal_exact);
+    g_test_add_func("/storage/match_literal/quantifiers", test_match_literal_quantifiers);
+    g_test_add_func("/storage/match_literal/unsupported", test_match_literal_unsupported);
+    g_test_add_func("/storage/match_literal/extended", test_match_literal_extended);
+    g_test_add_func("/storage/match_literal/caseless", test_match_literal_caseless);
+    return g_test_run();
+}
@@ -0,0 +1,124 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_012.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for RTP streams hash table keys
+ */
+
+#include "config.h"
+#include <string.h>
+#include <glib.h>
+#include "storage/storage.h"
+
+static void
+test_stream_key_fill()
+{
+    StorageStreamKey key;
+    g_assert_true(storage_stream_key(&key, "192.168.1.10", 4000));
+    g_assert_cmpuint(key.port, ==, 4000);
+    g_assert_cmpuint(key.addr[0], ==, 192);
+    g_assert_cmpuint(key.addr[3], ==, 10);
+
+    // Unused address bytes are always zeroed
+    for (guint i = 4; i < sizeof(key.addr); i++) {
+        g_assert_cmpuint(key.addr[i], ==, 0);
+    }
+
+    // Invalid addresses
+    g_assert_false(storage_stream_key(&key, NULL, 4000));
+    g_assert_false(storage_stream_key(&key, "", 4000));
+    g_assert_false(storage_stream_key(&key, "192.168.1", 4000));
+    g_assert_false(storage_stream_key(&key, "sip.example.com", 4000));
+}
+
+static void
+test_stream_key_equal()
+{
+    StorageStreamKey key, same, other_port, other_addr;
+    memset(&same, 0xFF, sizeof(StorageStreamKey));
+
+    g_assert_true(storage_stream_key(&key, "10.0.0.1", 10000));
+    g_assert_true(storage_stream_key(&same, "10.0.0.1", 10000));
+    g_assert_true(storage_stream_key(&other_port, "10.0.0.1", 10001));
+    g_assert_true(storage_stream_key(&other_addr, "10.0.0.2", 10000));
+
+    g_assert_true(storage_stream_key_equal(&key, &same));
+    g_assert_cmpuint(storage_stream_key_hash(&key), ==, storage_stream_key_hash(&same));
+
+    g_assert_false(storage_stream_key_equal(&key, &other_port));
+    g_assert_cmpuint(storage_stream_key_hash(&key), !=, storage_stream_key_hash(&other_port));
+    g_assert_false(storage_stream_key_equal(&key, &other_addr));
+    g_assert_cmpuint(storage_stream_key_hash(&key), !=, storage_stream_key_hash(&other_addr));
+}
+
+#ifdef USE_IPV6
+static void
+test_stream_key_ipv6()
+{
+    StorageStreamKey key, same, ipv4;
+    g_assert_true(storage_stream_key(&key, "2001:db8::1", 5060));
+    g_assert_true(storage_stream_key(&same, "2001:0db8:0:0:0:0:0:1", 5060));
+    g_assert_true(storage_stream_key(&ipv4, "32.1.13.184", 5060));
+
+    // Same address in different formats
+    g_assert_true(storage_stream_key_equal(&key, &same));
+    g_assert_cmpuint(storage_stream_key_hash(&key), ==, storage_stream_key_hash(&same));
+
+    // IPv4 address with the same first bytes
+    g_assert_false(storage_stream_key_equal(&key, &ipv4));
+}
+#endif
+
+static void
+test_stream_key_table()
+{
+    g_autoptr(GHashTable) streams = g_hash_table_new_full(
+        storage_stream_key_hash, storage_stream_key_equal, g_free, NULL
+    );
+
+    for (guint port = 10000; port < 10100; port += 2) {
+        StorageStreamKey *key = g_malloc(sizeof(StorageStreamKey));
+        g_assert_true(storage_stream_key(key, "10.0.0.1", (guint16) port));
+        g_hash_table_insert(streams, key, GUINT_TO_POINTER(port));
+    }
+
+    StorageStreamKey lookup;
+    g_assert_true(storage_stream_key(&lookup, "10.0.0.1", 10050));
+    g_assert_cmpuint(GPOINTER_TO_UINT(g_hash_table_lookup(streams, &lookup)), ==, 10050);
+    g_assert_true(storage_stream_key(&lookup, "10.0.0.1", 10051));
+    g_assert_null(g_hash_table_lookup(streams, &lookup));
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/storage/stream_key/fill", test_stream_key_fill);
+    g_test_add_func("/storage/stream_key/equal", test_stream_key_equal);
+#ifdef USE_IPV6
+    g_test_add_func("/storage/stream_key/ipv6", test_stream_key_ipv6);
+#endif
+    g_test_add_func("/storage/stream_key/table", test_stream_key_table);
+    return g_test_run();
+}
@@ -0,0 +1,113 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_013.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for date and time formatters
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <glib.h>
+#include "storage/datetime.h"
+
+//! 2019/03/05 14:07:09.000123 UTC
+#define TEST_TS (G_GUINT64_CONSTANT(1551794829) * G_USEC_PER_SEC + 123)
+
+static void
+test_date_time_date_to_str()
+{
+    gchar out[11];
+    g_assert_cmpstr(date_time_date_to_str(TEST_TS, out), ==, "2019/03/05");
+}
+
+static void
+test_date_time_time_to_str()
+{
+    gchar out[16];
+    g_assert_cmpstr(date_time_time_to_str(TEST_TS, out), ==, "14:07:09.000123");
+
+    // Same second uses cached time of day
+    g_assert_cmpstr(date_time_time_to_str(TEST_TS + 999000, out), ==, "14:07:09.999123");
+    g_assert_cmpstr(date_time_time_to_str(TEST_TS + G_USEC_PER_SEC, out), ==, "14:07:10.000123");
+}
+
+static void
+test_date_time_to_duration()
+{
+    gchar out[32];
+    g_assert_cmpstr(date_time_to_duration(TEST_TS, TEST_TS + 65 * G_USEC_PER_SEC, out), ==, "1:05");
+    g_assert_cmpstr(date_time_to_duration(TEST_TS, TEST_TS + 500000, out), ==, "0:00");
+
+    // Minutes are not limited to two digits
+    g_assert_cmpstr(date_time_to_duration(TEST_TS, TEST_TS + G_GUINT64_CONSTANT(6001) * G_USEC_PER_SEC, out), ==, "100:01");
+
+    // End before start
+    g_assert_cmpstr(date_time_to_duration(TEST_TS, TEST_TS - G_USEC_PER_SEC, out), ==, "0:00");
+
+    // Unknown times
+    g_assert_null(date_time_to_duration(0, TEST_TS, out));
+    g_assert_null(date_time_to_duration(TEST_TS, 0, out));
+}
+
+static void
+test_date_time_to_delta()
+{
+    gchar out[32];
+    g_assert_cmpstr(date_time_to_delta(TEST_TS, TEST_TS + 1500000, out), ==, "+1.500000");
+    g_assert_cmpstr(date_time_to_delta(TEST_TS, TEST_TS, out), ==, "+0.000000");
+    g_assert_cmpstr(date_time_to_delta(TEST_TS, TEST_TS - 2000042, out), ==, "-2.000042");
+    g_assert_cmpstr(date_time_to_delta(TEST_TS, TEST_TS + G_GUINT64_CONSTANT(6001) * G_USEC_PER_SEC, out), ==, "+6001.000000");
+    g_assert_null(date_time_to_delta(0, TEST_TS, out));
+}
+
+static void
+test_date_time_from_str()
+{
+    g_assert_cmpuint(date_time_from_str("2019/03/05 14:07:09", 0), ==, TEST_TS - 123);
+    g_assert_cmpuint(date_time_from_str("2019/03/05 14:07", 0), ==, TEST_TS - 123 - 9 * G_USEC_PER_SEC);
+
+    // Time without date uses reference date
+    g_assert_cmpuint(date_time_from_str("14:07:09", TEST_TS), ==, TEST_TS - 123);
+
+    // Invalid values
+    g_assert_cmpuint(date_time_from_str("25:00", TEST_TS), ==, 0);
+    g_assert_cmpuint(date_time_from_str("2019/13/05 14:07", TEST_TS), ==, 0);
+    g_assert_cmpuint(date_time_from_str("now", TEST_TS), ==, 0);
+}
+
+int
+main(int argc, char *argv[])
+{
+    // Formatted dates depend on local timezone
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/datetime/date_to_str", test_date_time_date_to_str);
+    g_test_add_func("/datetime/time_to_str", test_date_time_time_to_str);
+    g_test_add_func("/datetime/to_duration", test_date_time_to_duration);
+    g_test_add_func("/datetime/to_delta", test_date_time_to_delta);
+    g_test_add_func("/datetime/from_str", test_date_time_from_str);
+    return g_test_run();
+}
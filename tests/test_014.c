@@ -0,0 +1,121 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_014.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for dialogs memory arenas
+ */
+
+#include <string.h>
+#include <glib.h>
+#include "storage/arena.h"
+
+/**
+ * @brief Check the whole allocated block can be written
+ */
+static void
+test_arena_fill(gpointer ptr, gsize size)
+{
+    g_assert_nonnull(ptr);
+    for (gsize i = 0; i < size; i++) {
+        g_assert_cmpuint(((guint8 *) ptr)[i], ==, 0);
+    }
+    memset(ptr, 0xAA, size);
+}
+
+static void
+test_arena_alloc_small()
+{
+    Arena *arena = arena_new();
+    gsize size = arena_size(arena);
+
+    gpointer first = arena_alloc0(arena, 10);
+    gpointer second = arena_alloc0(arena, 10);
+    test_arena_fill(first, 10);
+    test_arena_fill(second, 10);
+
+    // Allocations are aligned and use the initial chunk
+    g_assert_cmpuint(GPOINTER_TO_SIZE(second) % G_MEM_ALIGN, ==, 0);
+    g_assert_true(second != first);
+    g_assert_cmpuint(arena_size(arena), ==, size);
+
+    arena_free(arena);
+}
+
+static void
+test_arena_alloc_grow()
+{
+    // Bigger than the next chunk but not a big allocation
+    gsize size = 3000;
+    g_assert_cmpuint(size, >, ARENA_CHUNK_MIN * 2);
+    g_assert_cmpuint(size, <=, ARENA_CHUNK_MAX / 4);
+
+    Arena *arena = arena_new();
+    gsize initial = arena_size(arena);
+    test_arena_fill(arena_alloc0(arena, size), size);
+    g_assert_cmpuint(arena_size(arena), >=, initial + size);
+
+    // Following allocations still fit
+    test_arena_fill(arena_alloc0(arena, 100), 100);
+    arena_free(arena);
+}
+
+static void
+test_arena_alloc_big()
+{
+    Arena *arena = arena_new();
+    gsize size = ARENA_CHUNK_MAX * 2;
+    test_arena_fill(arena_alloc0(arena, size), size);
+    g_assert_cmpuint(arena_size(arena), >=, size + ARENA_CHUNK_MIN);
+
+    // Current chunk keeps being used after big allocations
+    gsize current = arena_size(arena);
+    test_arena_fill(arena_alloc0(arena, 16), 16);
+    g_assert_cmpuint(arena_size(arena), ==, current);
+    arena_free(arena);
+}
+
+static void
+test_arena_strdup()
+{
+    Arena *arena = arena_new();
+    g_assert_null(arena_strdup(arena, NULL));
+    g_assert_cmpstr(arena_strdup(arena, "sip:alice@example.com"), ==, "sip:alice@example.com");
+
+    gchar *text = g_strnfill(5000, 'x');
+    g_assert_cmpstr(arena_strdup(arena, text), ==, text);
+    g_free(text);
+
+    arena_free(arena);
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/arena/alloc/small", test_arena_alloc_small);
+    g_test_add_func("/arena/alloc/grow", test_arena_alloc_grow);
+    g_test_add_func("/arena/alloc/big", test_arena_alloc_big);
+    g_test_add_func("/arena/strdup", test_arena_strdup);
+    return g_test_run();
+}
@@ -0,0 +1,92 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_015.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for interned strings
+ */
+
+#include <glib.h>
+#include "storage/intern.h"
+
+static void
+test_intern_string()
+{
+    gchar *text = g_strdup("sip:alice@example.com");
+    const gchar *first = intern_string(text);
+    const gchar *second = intern_string("sip:alice@example.com");
+    const gchar *other = intern_string("sip:bob@example.com");
+
+    // Equal strings share the same interned copy
+    g_assert_true(first != text);
+    g_assert_true(first == second);
+    g_assert_true(first != other);
+    g_assert_cmpstr(first, ==, text);
+    g_assert_cmpstr(other, ==, "sip:bob@example.com");
+    g_free(text);
+
+    intern_unref(first);
+    intern_unref(second);
+    intern_unref(other);
+}
+
+static void
+test_intern_null()
+{
+    g_assert_null(intern_string(NULL));
+    g_assert_null(intern_ref(NULL));
+    intern_unref(NULL);
+}
+
+static void
+test_intern_refcount()
+{
+    const gchar *str = intern_string("INVITE");
+    g_assert_true(intern_ref(str) == str);
+    g_assert_true(intern_string("INVITE") == str);
+
+    // String is kept while it has references
+    intern_unref(str);
+    intern_unref(str);
+    g_assert_cmpstr(str, ==, "INVITE");
+    g_assert_true(intern_string("INVITE") == str);
+    intern_unref(str);
+
+    // Last reference released, a new copy is interned
+    intern_unref(str);
+    str = intern_string("INVITE");
+    g_assert_cmpstr(str, ==, "INVITE");
+    g_assert_true(intern_ref(str) == str);
+    intern_unref(str);
+    intern_unref(str);
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/intern/string", test_intern_string);
+    g_test_add_func("/intern/null", test_intern_null);
+    g_test_add_func("/intern/refcount", test_intern_refcount);
+    return g_test_run();
+}
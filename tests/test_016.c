@@ -0,0 +1,148 @@
+/**************************************************************************
+ **
+ ** sngrep - SIP Messages flow viewer
+ **
+ ** Copyright (C) 2013-2019 Ivan Alonso (Kaian)
+ ** Copyright (C) 2013-2019 Irontec SL. All rights reserved.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ ****************************************************************************/
+/**
+ * @file test_016.c
+ * @author Ivan Alonso [aka Kaian] <kaian@irontec.com>
+ *
+ * Unit tests for payload trigram index
+ */
+
+#include <string.h>
+#include <glib.h>
+#include "storage/storage_trigram.h"
+
+/**
+ * @brief Add a text to the index
+ */
+static void
+test_trigram_add(StorageTrigramIndex *index, guint32 id, const gchar *text)
+{
+    storage_trigram_index_add(index, id, text, strlen(text));
+}
+
+/**
+ * @brief Check the identifiers returned when searching a text
+ */
+static void
+test_trigram_assert_lookup(StorageTrigramIndex *index, const gchar *text, const guint32 *ids, guint count)
+{
+    GArray *result = storage_trigram_index_lookup(index, text, strlen(text));
+    g_assert_nonnull(result);
+    g_assert_cmpuint(result->len, ==, count);
+    for (guint i = 0; i < count; i++) {
+        g_assert_cmpuint(g_array_index(result, guint32, i), ==, ids[i]);
+    }
+    g_array_free(result, TRUE);
+}
+
+static void
+test_trigram_lookup()
+{
+    StorageTrigramIndex *index = storage_trigram_index_new();
+    test_trigram_add(index, 1, "INVITE sip:alice@example.com SIP/2.0");
+    test_trigram_add(index, 2, "BYE sip:bob@example.com SIP/2.0");
+    test_trigram_add(index, 3, "INVITE sip:bob@example.org SIP/2.0");
+
+    const guint32 all[] = { 1, 2, 3 };
+    const guint32 invite[] = { 1, 3 };
+    const guint32 bob[] = { 2, 3 };
+    const guint32 bob_com[] = { 2 };
+
+    test_trigram_assert_lookup(index, "sip", all, 3);
+    test_trigram_assert_lookup(index, "INVITE", invite, 2);
+    test_trigram_assert_lookup(index, "bob@", bob, 2);
+    test_trigram_assert_lookup(index, "bob@example.com", bob_com, 1);
+    test_trigram_assert_lookup(index, "carol", NULL, 0);
+
+    // Searches are case insensitive
+    test_trigram_assert_lookup(index, "invite", invite, 2);
+    test_trigram_assert_lookup(index, "BOB@EXAMPLE.COM", bob_com, 1);
+
+    // Texts shorter than a trigram can not be searched
+    g_assert_null(storage_trigram_index_lookup(index, "si", 2));
+
+    storage_trigram_index_free(index);
+}
+
+static void
+test_trigram_add_order()
+{
+    StorageTrigramIndex *index = storage_trigram_index_new();
+
+    // Identifiers added out of order and more than once
+    test_trigram_add(index, 5, "REGISTER");
+    test_trigram_add(index, 2, "REGISTER");
+    test_trigram_add(index, 9, "REGISTER");
+    test_trigram_add(index, 5, "register");
+    test_trigram_add(index, 1, "REGISTER");
+
+    const guint32 ids[] = { 1, 2, 5, 9 };
+    test_trigram_assert_lookup(index, "register", ids, 4);
+
+    // Short data is not indexed
+    gsize size = index->size;
+    test_trigram_add(index, 10, "RE");
+    g_assert_cmpuint(index->size, ==, size);
+
+    storage_trigram_index_free(index);
+}
+
+static gboolean
+test_trigram_keep_odd(guint32 id, G_GNUC_UNUSED gpointer user_data)
+{
+    return id % 2 == 1;
+}
+
+static void
+test_trigram_prune()
+{
+    StorageTrigramIndex *index = storage_trigram_index_new();
+    test_trigram_add(index, 1, "OPTIONS");
+    test_trigram_add(index, 2, "OPTIONS");
+    test_trigram_add(index, 3, "OPTIONS");
+    test_trigram_add(index, 4, "NOTIFY");
+    gsize size = index->size;
+
+    storage_trigram_index_prune(index, test_trigram_keep_odd, NULL);
+    g_assert_cmpuint(index->size, <, size);
+
+    const guint32 odd[] = { 1, 3 };
+    test_trigram_assert_lookup(index, "options", odd, 2);
+    test_trigram_assert_lookup(index, "notify", NULL, 0);
+
+    // Clearing removes all posting lists
+    storage_trigram_index_clear(index);
+    g_assert_cmpuint(index->size, ==, 0);
+    test_trigram_assert_lookup(index, "options", NULL, 0);
+
+    storage_trigram_index_free(index);
+}
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/trigram/lookup", test_trigram_lookup);
+    g_test_add_func("/trigram/add_order", test_trigram_add_order);
+    g_test_add_func("/trigram/prune", test_trigram_prune);
+    return g_test_run();
+}